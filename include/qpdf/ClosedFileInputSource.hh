@@ -26,10 +26,14 @@
 
 class FileInputSource;
 
-// This is an input source that reads from files, like FileInputSource, except that it opens and
-// closes the file surrounding every operation. This decreases efficiency, but it allows many more
-// of these to exist at once than the maximum number of open file descriptors. This is used for
-// merging large numbers of files.
+// This is an input source that reads from files, like FileInputSource, except that it doesn't keep
+// its file open. After each operation, the file is placed in a process-wide pool of open files
+// shared by all ClosedFileInputSource objects. When the pool is full, the least recently used file
+// is closed and reopened the next time its input source is accessed. This allows many more of these
+// to exist at once than the maximum number of open file descriptors. This is used for merging large
+// numbers of files. The size of the pool can be set with
+// qpdf::global::options::closed_file_pool_size (see qpdf/global.hh). If it is 0, files are closed
+// after every operation.
 class QPDF_DLL_CLASS ClosedFileInputSource: public InputSource
 {
   public:
@@ -281,6 +281,10 @@ enum qpdf_param_e {
     qpdf_p_fuzz_mode = 0x11010,
     qpdf_p_default_limits = 0x11100,
 
+    /* input options */
+    qpdf_p_closed_file_pool_size = 0x11200,
+    qpdf_p_mmap_input = 0x11210,
+
     /* stream and filter options */
     qpdf_p_dct_throw_on_corrupt_data = 0x11400,
 
@@ -26,6 +26,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <string_view>
 
 // Remember to use QPDF_DLL_CLASS on anything derived from InputSource so it will work with
 // dynamic_cast across the shared object boundary.
@@ -83,6 +84,8 @@ class QPDF_DLL_CLASS InputSource
     inline qpdf_offset_t fastTell();
     inline bool fastRead(char&);
     inline void fastUnread(bool);
+    inline std::string_view fastView();
+    inline void fastSkip(size_t);
     inline void loadBuffer();
 
   protected:
@@ -66,6 +66,10 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
     QPDF_DLL
     static void setCompressionLevel(int);
 
+    // Return the compression level set with setCompressionLevel.
+    QPDF_DLL
+    static int getCompressionLevel();
+
     QPDF_DLL
     void setWarnCallback(std::function<void(char const*, int)> callback);
 
@@ -86,6 +90,27 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
     QPDF_DLL
     static bool zopfli_check_env(QPDFLogger* logger = nullptr);
 
+    // Returns true if qpdf was built with libdeflate support.
+    QPDF_DLL
+    static bool libdeflate_supported();
+
+    // Returns true if libdeflate is used for the given action. libdeflate is much faster than zlib
+    // but only works on complete buffers. Pl_Flate itself always inflates with zlib since it can't
+    // tell whether it has been given all of the data. qpdf uses libdeflate when it decodes stream
+    // data that is in memory in one step, and zlib if that data is not a complete zlib stream. When
+    // deflating, all data is collected and deflated in finish().
+    // If libdeflate support is compiled in, it is used for inflating unless the QPDF_LIBDEFLATE
+    // environment variable is set to "disabled". Since its compressed output differs from zlib's,
+    // it is only used for deflating if QPDF_LIBDEFLATE is set to "deflate". Zopfli takes precedence
+    // over libdeflate.
+    QPDF_DLL
+    static bool libdeflate_enabled(action_e action);
+
+    // Override the default for the given action. This has no effect if libdeflate support is not
+    // compiled in.
+    QPDF_DLL
+    static void libdeflate_enabled(action_e action, bool enabled);
+
   private:
     QPDF_DLL_PRIVATE
     void handleData(unsigned char const* data, size_t len, int flush);
@@ -95,6 +120,8 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
     void warn(char const*, int error_code);
     QPDF_DLL_PRIVATE
     void finish_zopfli();
+    QPDF_DLL_PRIVATE
+    void finish_libdeflate();
 
     QPDF_DLL_PRIVATE
     static int compression_level;
@@ -118,6 +145,7 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
         unsigned long long written{0};
         std::function<void(char const*, int)> callback;
         std::unique_ptr<std::string> zopfli_buf;
+        std::unique_ptr<std::string> libdeflate_buf;
     };
 
     std::unique_ptr<Members> m;
@@ -267,6 +267,17 @@ class QPDF
     QPDF_DLL
     void setImmediateCopyFrom(bool);
 
+    // If true, long arrays that only contain scalars and indirect references, such as the /Kids
+    // array of a large page tree node or a large /Annots array, are read lazily: when reading such
+    // an array from the input file, only the positions of its elements are recorded, and each
+    // element is parsed when it is first accessed. This makes reading files with many large arrays
+    // faster when only some of their elements are used. Arrays read lazily keep the input source
+    // open until all objects read from this QPDF object have been destroyed, so don't enable this
+    // if you intend to call closeInputSource. This method must be called before calling processFile
+    // or any of the other process methods.
+    QPDF_DLL
+    void setLazyArrays(bool);
+
     // Other public methods
 
     // Return the list of warnings that have been issued so far and clear the list.  This method may
@@ -661,7 +672,8 @@ class QPDF
     size_t getObjectCount();
 
     // Returns a list of indirect objects for every object in the xref table. Useful for discovering
-    // objects that are not otherwise referenced.
+    // objects that are not otherwise referenced. Objects that have not yet been read are read in
+    // the order in which they appear in the file, and each object stream is only parsed once.
     QPDF_DLL
     std::vector<QPDFObjectHandle> getAllObjects();
 
@@ -210,6 +210,24 @@ class QPDFWriter
     QPDF_DLL
     void setRecompressFlate(bool);
 
+    // Compress streams with Flate on up to the given number of additional threads while the
+    // calling thread reads, decodes, and writes the other objects. The default is 0, which
+    // compresses all streams on the calling thread. The output is identical regardless of the
+    // number of threads. This mostly helps when many streams are recompressed, especially with a
+    // high compression level or with zopfli.
+    QPDF_DLL
+    void setCompressionThreads(size_t threads);
+
+    // When compressing streams on additional threads, split streams larger than the given number
+    // of bytes into blocks of that size and compress the blocks in parallel. This lets several
+    // threads work on a single very large stream. The blocks are combined into a single valid
+    // Flate stream, which is typically very slightly larger than the one created without this
+    // option. The default is 0, which compresses each stream as a whole. This has no effect unless
+    // setCompressionThreads has been called with a non-zero value, and no effect when zopfli is
+    // enabled.
+    QPDF_DLL
+    void setDeflateBlockSize(size_t bytes);
+
     // Set value of content stream normalization.  The default is "false".  If true, we attempt to
     // normalize newlines inside of content streams.  Some constructs such as inline images may
     // thwart our efforts.  There may be some cases where this can damage the content stream.  This
@@ -224,6 +242,17 @@ class QPDFWriter
     QPDF_DLL
     void setQDFMode(bool);
 
+    // Write stream lengths as indirect objects following each stream rather than directly in the
+    // stream dictionary. The default is "true", i.e. direct stream lengths, except in QDF mode.
+    // With indirect stream lengths, the data of streams that are written without filtering is
+    // written straight to the output instead of being collected in memory first, which can
+    // significantly reduce memory use when writing files with very large streams. Object streams,
+    // cross-reference streams, and hint streams always get direct stream lengths. Indirect stream
+    // lengths can't be used with linearization, and direct stream lengths can't be used in QDF mode
+    // because fix-qdf relies on indirect stream lengths.
+    QPDF_DLL
+    void setDirectStreamLengths(bool);
+
     // Preserve unreferenced objects. The default behavior is to discard any object that is not
     // visited during a traversal of the object structure from the trailer.
     QPDF_DLL
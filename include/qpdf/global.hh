@@ -133,6 +133,71 @@ namespace qpdf::global
             set_uint32(qpdf_p_fuzz_mode, value ? QPDF_TRUE : QPDF_FALSE);
         }
 
+        /// @brief  Retrieves the maximum number of files kept open by idle ClosedFileInputSource
+        ///         objects.
+        ///
+        /// ClosedFileInputSource objects share a process-wide pool of open file handles. When a
+        /// ClosedFileInputSource finishes an operation, its file is kept open and added to the
+        /// pool. If the pool is full, the file of the least recently used ClosedFileInputSource is
+        /// closed, and that input source reopens it the next time it is accessed. A value of 0
+        /// means that files are closed after every operation. The default is 64.
+        ///
+        /// @return The maximum number of files kept open by idle ClosedFileInputSource objects.
+        ///
+        /// @since 12.4
+        inline uint32_t
+        closed_file_pool_size()
+        {
+            return get_uint32(qpdf_p_closed_file_pool_size);
+        }
+
+        /// @brief  Sets the maximum number of files kept open by idle ClosedFileInputSource
+        ///         objects.
+        ///
+        /// See `closed_file_pool_size()` for details. If the new value is smaller than the number
+        /// of files currently in the pool, excess files are closed the next time a
+        /// ClosedFileInputSource finishes an operation.
+        ///
+        /// @param value The maximum number of files to keep open. 0 disables the pool.
+        ///
+        /// @since 12.4
+        inline void
+        closed_file_pool_size(uint32_t value)
+        {
+            set_uint32(qpdf_p_closed_file_pool_size, value);
+        }
+
+        /// @brief  Retrieves whether input files are memory-mapped.
+        ///
+        /// When enabled, `QPDF::processFile` and the qpdf command-line tool memory-map regular
+        /// input files on systems that support `mmap` and read directly from the mapping instead of
+        /// going through stdio. If another process truncates a mapped file while qpdf is reading
+        /// it, the process is terminated with `SIGBUS` instead of qpdf reporting an unexpected end
+        /// of file, so this option should only be enabled for files that are not modified while
+        /// they are being read. By default this option is off.
+        ///
+        /// @return True if input files are memory-mapped.
+        ///
+        /// @since 12.4
+        inline bool
+        mmap_input()
+        {
+            return get_uint32(qpdf_p_mmap_input) != 0;
+        }
+
+        /// @brief  Set whether input files are memory-mapped.
+        ///
+        /// See `mmap_input()` for details. The option affects files opened after it has been set.
+        ///
+        /// @param value A boolean indicating whether to memory-map input files.
+        ///
+        /// @since 12.4
+        inline void
+        mmap_input(bool value)
+        {
+            set_uint32(qpdf_p_mmap_input, value ? QPDF_TRUE : QPDF_FALSE);
+        }
+
         /// @brief  Retrieves whether DCT throw-on-corrupt-data option is set.
         ///
         /// When enabled, DCT decompression will treat corrupt data as an error and throw an
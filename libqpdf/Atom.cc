@@ -0,0 +1,72 @@
+#include <qpdf/Atom.hh>
+
+#include <qpdf/Util.hh>
+
+#include <algorithm>
+#include <array>
+
+using namespace qpdf;
+
+namespace
+{
+    constexpr std::array<std::string_view, atom::count> names{
+        "",
+#define QPDF_ATOM_NAME(name) "/" #name,
+        QPDF_ATOMS(QPDF_ATOM_NAME)
+#undef QPDF_ATOM_NAME
+    };
+
+    // Atoms are ordered like their names.
+    qpdf_static_expect(std::ranges::is_sorted(names));
+
+    // Atoms are found through an open addressing hash table of their ids. The hash only looks at
+    // the size and at the first and last characters of a name, which tells most standard names
+    // apart, so a lookup usually compares a single name.
+    constexpr size_t table_size = 1024;
+    qpdf_static_expect(atom::count < table_size / 2);
+
+    constexpr size_t
+    hash(std::string_view name)
+    {
+        return (name.size() * 67 + static_cast<unsigned char>(name[1]) * 31 +
+                static_cast<unsigned char>(name.back())) %
+            table_size;
+    }
+
+    constexpr auto table = [] {
+        std::array<std::uint16_t, table_size> result{};
+        for (std::uint16_t i = 1; i < names.size(); ++i) {
+            auto h = hash(names[i]);
+            while (result[h]) {
+                h = (h + 1) % table_size;
+            }
+            result[h] = i;
+        }
+        return result;
+    }();
+} // namespace
+
+atom::id
+atom::find(std::string_view name)
+{
+    if (name.size() < 2 || name.front() != '/') {
+        return none;
+    }
+    for (auto h = hash(name); table[h]; h = (h + 1) % table_size) {
+        if (names[table[h]] == name) {
+            return static_cast<id>(table[h]);
+        }
+    }
+    return none;
+}
+
+std::string const&
+atom::name(id a)
+{
+    static std::array<std::string, count> const strings = [] {
+        std::array<std::string, count> result;
+        std::ranges::copy(names, result.begin());
+        return result;
+    }();
+    return strings.at(a);
+}
@@ -293,3 +293,23 @@ is::OffsetBuffer::read(char* buffer, size_t length)
     pos += QIntC::to_offset(len);
     return len;
 }
+
+std::string_view
+is::OffsetBuffer::view(size_t count, qpdf_offset_t at)
+{
+    if (at >= 0) {
+        seek(at, SEEK_SET);
+    }
+    util::internal_error_if(pos < 0, "is::OffsetBuffer offset < 0");
+    auto end_pos = static_cast<qpdf_offset_t>(view_.size());
+    if (pos >= end_pos) {
+        last_offset = end_pos + global_offset;
+        return {};
+    }
+
+    last_offset = pos + global_offset;
+    size_t len = std::min(QIntC::to_size(end_pos - pos), count);
+    auto result = view_.substr(QIntC::to_size(pos), len);
+    pos += QIntC::to_offset(len);
+    return result;
+}
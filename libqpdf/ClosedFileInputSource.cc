@@ -1,20 +1,71 @@
 #include <qpdf/ClosedFileInputSource.hh>
 
 #include <qpdf/FileInputSource.hh>
+#include <qpdf/global_private.hh>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace qpdf;
+
+namespace
+{
+    // Process-wide pool of idle ClosedFileInputSource objects whose files are open, ordered from
+    // most to least recently used. The pool is shared by all ClosedFileInputSource objects, which
+    // may be used from different threads, so all access to it and to the fis member of pooled
+    // objects must happen while holding the mutex.
+    struct Pool
+    {
+        std::mutex mutex;
+        std::list<ClosedFileInputSource*> lru;
+        std::unordered_map<ClosedFileInputSource*, std::list<ClosedFileInputSource*>::iterator>
+            entries;
+
+        // The pool is never destroyed so that ClosedFileInputSource objects that outlive static
+        // destruction, such as ones owned by static or leaked QPDF objects, can still use it.
+        static Pool&
+        instance()
+        {
+            static Pool& pool = *new Pool;
+            return pool;
+        }
+
+        // Remove cfis from the pool if present. Must be called with the mutex held.
+        void
+        remove(ClosedFileInputSource* cfis)
+        {
+            if (auto it = entries.find(cfis); it != entries.end()) {
+                lru.erase(it->second);
+                entries.erase(it);
+            }
+        }
+    };
+} // namespace
 
 ClosedFileInputSource::ClosedFileInputSource(char const* filename) :
     filename(filename)
 {
 }
 
-ClosedFileInputSource::~ClosedFileInputSource() // NOLINT (modernize-use-equals-default)
+ClosedFileInputSource::~ClosedFileInputSource()
 {
     // Must be explicit and not inline -- see QPDF_DLL_CLASS in README-maintainer
+    auto& pool = Pool::instance();
+    std::lock_guard lock(pool.mutex);
+    pool.remove(this);
 }
 
 void
 ClosedFileInputSource::before()
 {
+    {
+        // While we are using the file, it must not be closed by another ClosedFileInputSource
+        // evicting us from the pool.
+        auto& pool = Pool::instance();
+        std::lock_guard lock(pool.mutex);
+        pool.remove(this);
+    }
     if (nullptr == this->fis) {
         this->fis = std::make_shared<FileInputSource>(this->filename.c_str());
         this->fis->seek(this->offset, SEEK_SET);
@@ -30,7 +81,23 @@ ClosedFileInputSource::after()
     if (this->stay_open) {
         return;
     }
-    this->fis = nullptr;
+    auto& pool = Pool::instance();
+    std::lock_guard lock(pool.mutex);
+    auto max_size = global::Options::closed_file_pool_size();
+    if (max_size == 0) {
+        this->fis = nullptr;
+        return;
+    }
+    // Keep the file open and evict least recently used sources until the pool fits.
+    pool.remove(this);
+    pool.lru.push_front(this);
+    pool.entries[this] = pool.lru.begin();
+    while (pool.lru.size() > max_size) {
+        auto* victim = pool.lru.back();
+        pool.entries.erase(victim);
+        pool.lru.pop_back();
+        victim->fis = nullptr;
+    }
 }
 
 qpdf_offset_t
@@ -68,6 +135,8 @@ ClosedFileInputSource::seek(qpdf_offset_t offset, int whence)
 void
 ClosedFileInputSource::rewind()
 {
+    auto& pool = Pool::instance();
+    std::lock_guard lock(pool.mutex);
     this->offset = 0;
     if (this->fis.get()) {
         this->fis->rewind();
@@ -94,6 +163,11 @@ ClosedFileInputSource::unreadCh(char ch)
 void
 ClosedFileInputSource::stayOpen(bool val)
 {
+    {
+        auto& pool = Pool::instance();
+        std::lock_guard lock(pool.mutex);
+        pool.remove(this);
+    }
     this->stay_open = val;
     if ((!val) && this->fis.get()) {
         after();
@@ -0,0 +1,109 @@
+#include <qpdf/qpdf-config.h> // include first for large file support
+
+#include <qpdf/MmapInputSource.hh>
+
+#include <qpdf/FileInputSource.hh>
+#include <qpdf/global_private.hh>
+
+#include <limits>
+#include <utility>
+
+#ifdef HAVE_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+std::shared_ptr<InputSource>
+MmapInputSource::create(std::string const& filename)
+{
+#ifdef HAVE_MMAP
+    int fd = qpdf::global::Options::mmap_input() ? open(filename.data(), O_RDONLY) : -1;
+    if (fd >= 0) {
+        void* addr = MAP_FAILED;
+        size_t size = 0;
+        struct stat st;
+        // Files whose size doesn't fit in size_t, which can happen on 32-bit systems with large
+        // file support, can't be mapped as a whole and are read with FileInputSource.
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+            std::cmp_less_equal(st.st_size, std::numeric_limits<size_t>::max())) {
+            size = static_cast<size_t>(st.st_size);
+            addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (addr != MAP_FAILED) {
+            return std::shared_ptr<InputSource>(
+                new MmapInputSource(filename, {static_cast<char const*>(addr), size}));
+        }
+    }
+#endif
+    return std::make_shared<FileInputSource>(filename.data());
+}
+
+MmapInputSource::MmapInputSource(std::string const& filename, std::string_view data) :
+    data_(data),
+    is(filename, data)
+{
+}
+
+MmapInputSource::~MmapInputSource()
+{
+#ifdef HAVE_MMAP
+    munmap(const_cast<char*>(data_.data()), data_.size());
+#endif
+}
+
+qpdf_offset_t
+MmapInputSource::findAndSkipNextEOL()
+{
+    auto result = is.findAndSkipNextEOL();
+    last_offset = is.getLastOffset();
+    return result;
+}
+
+std::string const&
+MmapInputSource::getName() const
+{
+    return is.getName();
+}
+
+qpdf_offset_t
+MmapInputSource::tell()
+{
+    return is.tell();
+}
+
+void
+MmapInputSource::seek(qpdf_offset_t offset, int whence)
+{
+    is.seek(offset, whence);
+}
+
+void
+MmapInputSource::rewind()
+{
+    is.rewind();
+}
+
+size_t
+MmapInputSource::read(char* buffer, size_t length)
+{
+    auto result = is.read(buffer, length);
+    last_offset = is.getLastOffset();
+    return result;
+}
+
+std::string_view
+MmapInputSource::view(size_t count, qpdf_offset_t at)
+{
+    auto result = is.view(count, at);
+    last_offset = is.getLastOffset();
+    return result;
+}
+
+void
+MmapInputSource::unreadCh(char ch)
+{
+    is.unreadCh(ch);
+}
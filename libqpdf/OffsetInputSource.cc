@@ -67,6 +67,23 @@ OffsetInputSource::read(char* buffer, size_t length)
     return result;
 }
 
+bool
+OffsetInputSource::in_memory() const
+{
+    return qpdf::is::in_memory(*proxied);
+}
+
+std::string_view
+OffsetInputSource::view(size_t count, qpdf_offset_t at)
+{
+    if (at >= 0) {
+        seek(at, SEEK_SET);
+    }
+    auto result = qpdf::is::view(*proxied, count).value();
+    setLastOffset(proxied->getLastOffset() - global_offset);
+    return result;
+}
+
 void
 OffsetInputSource::unreadCh(char ch)
 {
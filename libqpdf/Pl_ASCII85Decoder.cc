@@ -3,6 +3,8 @@
 #include <qpdf/QTC.hh>
 #include <qpdf/Util.hh>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 
@@ -20,53 +22,86 @@ Pl_ASCII85Decoder::write(unsigned char const* buf, size_t len)
     if (eod > 1) {
         return;
     }
-    for (size_t i = 0; i < len; ++i) {
-        switch (buf[i]) {
-        case ' ':
-        case '\f':
-        case '\v':
-        case '\t':
-        case '\r':
-        case '\n':
-            QTC::TC("libtests", "Pl_ASCII85Decoder ignore space");
-            // ignore whitespace
-            continue;
-        }
-        if (eod > 1) {
-            break;
-        } else if (eod == 1) {
-            util::no_ci_rt_error_if(buf[i] != '>', "broken end-of-data sequence in base 85 data");
-            flush();
-            eod = 2;
-        } else {
+    output.clear();
+    try {
+        for (size_t i = 0; i < len; ++i) {
+            if (pos == 0 && eod == 0) {
+                // Decode complete groups of five characters directly, leaving whitespace, 'z',
+                // the end-of-data marker and errors to the loop below.
+                for (; len - i >= 5; i += 5) {
+                    auto const* group = buf + i;
+                    if (!std::all_of(group, group + 5, [](unsigned char c) {
+                            return c >= 33 && c <= 117;
+                        })) {
+                        break;
+                    }
+                    // Groups that overflow 32 bits keep the low-order bytes, as in flush.
+                    std::uint32_t val = 0;
+                    for (int j = 0; j < 5; ++j) {
+                        val = val * 85 + (group[j] - 33U);
+                    }
+                    char out[4] = {
+                        static_cast<char>(val >> 24),
+                        static_cast<char>(val >> 16),
+                        static_cast<char>(val >> 8),
+                        static_cast<char>(val)};
+                    output.append(out, 4);
+                }
+                if (i == len) {
+                    break;
+                }
+            }
             switch (buf[i]) {
-            case '~':
-                eod = 1;
+            case ' ':
+            case '\f':
+            case '\v':
+            case '\t':
+            case '\r':
+            case '\n':
+                QTC::TC("libtests", "Pl_ASCII85Decoder ignore space");
+                // ignore whitespace
+                continue;
+            }
+            if (eod > 1) {
                 break;
+            } else if (eod == 1) {
+                util::no_ci_rt_error_if(
+                    buf[i] != '>', "broken end-of-data sequence in base 85 data");
+                flush();
+                eod = 2;
+            } else {
+                switch (buf[i]) {
+                case '~':
+                    eod = 1;
+                    break;
 
-            case 'z':
-                if (pos != 0) {
-                    throw std::runtime_error("unexpected z during base 85 decode");
-                }
-                unsigned char zeroes[4];
-                memset(zeroes, '\0', 4);
-                next()->write(zeroes, 4);
-                break;
+                case 'z':
+                    if (pos != 0) {
+                        throw std::runtime_error("unexpected z during base 85 decode");
+                    }
+                    output.append(4, '\0');
+                    break;
 
-            default:
-                if (buf[i] < 33 || buf[i] > 117) {
-                    error = true;
-                    throw std::runtime_error("character out of range during base 85 decode");
-                } else {
-                    this->inbuf[this->pos++] = buf[i];
-                    if (pos == 5) {
-                        flush();
+                default:
+                    if (buf[i] < 33 || buf[i] > 117) {
+                        error = true;
+                        throw std::runtime_error("character out of range during base 85 decode");
+                    } else {
+                        this->inbuf[this->pos++] = buf[i];
+                        if (pos == 5) {
+                            flush();
+                        }
                     }
+                    break;
                 }
-                break;
             }
         }
+    } catch (...) {
+        // Pass on what was decoded before the error.
+        write_output();
+        throw;
     }
+    write_output();
 }
 
 void
@@ -89,12 +124,19 @@ Pl_ASCII85Decoder::flush()
     }
 
     QTC::TC("libtests", "Pl_ASCII85Decoder partial flush", (this->pos == 5) ? 0 : 1);
-    // Reset before calling getNext()->write in case that throws an exception.
     auto t = this->pos - 1;
     this->pos = 0;
     memset(this->inbuf, 117, 5);
 
-    next()->write(outbuf, t);
+    output.append(reinterpret_cast<char const*>(outbuf), t);
+}
+
+void
+Pl_ASCII85Decoder::write_output()
+{
+    if (!output.empty()) {
+        next()->write(reinterpret_cast<unsigned char const*>(output.data()), output.size());
+    }
 }
 
 void
@@ -103,6 +145,8 @@ Pl_ASCII85Decoder::finish()
     if (error) {
         return;
     }
+    output.clear();
     flush();
+    write_output();
     next()->finish();
 }
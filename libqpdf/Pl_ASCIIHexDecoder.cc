@@ -21,42 +21,65 @@ Pl_ASCIIHexDecoder::write(unsigned char const* buf, size_t len)
     if (eod) {
         return;
     }
-    for (size_t i = 0; i < len; ++i) {
-        char ch = static_cast<char>(toupper(buf[i]));
-        switch (ch) {
-        case ' ':
-        case '\f':
-        case '\v':
-        case '\t':
-        case '\r':
-        case '\n':
-            QTC::TC("libtests", "Pl_ASCIIHexDecoder ignore space");
-            // ignore whitespace
-            break;
+    output.clear();
+    try {
+        for (size_t i = 0; i < len; ++i) {
+            if (pos == 0) {
+                // Decode pairs of hex digits directly, leaving everything else to the loop below.
+                for (; len - i >= 2; i += 2) {
+                    auto high = util::hex_decode_table[buf[i]];
+                    auto low = util::hex_decode_table[buf[i + 1]];
+                    if ((high | low) >= '\20') {
+                        break;
+                    }
+                    output += static_cast<char>((high << 4) | low);
+                }
+                if (i == len) {
+                    break;
+                }
+            }
+            char ch = static_cast<char>(toupper(buf[i]));
+            switch (ch) {
+            case ' ':
+            case '\f':
+            case '\v':
+            case '\t':
+            case '\r':
+            case '\n':
+                QTC::TC("libtests", "Pl_ASCIIHexDecoder ignore space");
+                // ignore whitespace
+                break;
 
-        case '>':
-            eod = true;
-            flush();
-            break;
+            case '>':
+                eod = true;
+                flush();
+                break;
 
-        default:
-            if ((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'F')) {
-                inbuf[pos++] = ch;
-                if (pos == 2) {
-                    flush();
+            default:
+                if ((ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'F')) {
+                    inbuf[pos++] = ch;
+                    if (pos == 2) {
+                        flush();
+                    }
+                } else {
+                    char t[2];
+                    t[0] = ch;
+                    t[1] = 0;
+                    throw std::runtime_error(
+                        "character out of range during base Hex decode: "s + t);
                 }
-            } else {
-                char t[2];
-                t[0] = ch;
-                t[1] = 0;
-                throw std::runtime_error("character out of range during base Hex decode: "s + t);
+                break;
+            }
+            if (eod) {
+                break;
             }
-            break;
-        }
-        if (eod) {
-            break;
         }
+    } catch (...) {
+        // Pass on what was decoded before the error.
+        write_output();
+        throw;
     }
+    write_output();
 }
 
 void
@@ -77,18 +100,27 @@ Pl_ASCIIHexDecoder::flush()
     auto ch = static_cast<unsigned char>((b[0] << 4) + b[1]);
 
     QTC::TC("libtests", "Pl_ASCIIHexDecoder partial flush", (pos == 2) ? 0 : 1);
-    // Reset before calling getNext()->write in case that throws an exception.
     pos = 0;
     inbuf[0] = '0';
     inbuf[1] = '0';
     inbuf[2] = '\0';
 
-    next()->write(&ch, 1);
+    output += static_cast<char>(ch);
+}
+
+void
+Pl_ASCIIHexDecoder::write_output()
+{
+    if (!output.empty()) {
+        next()->write(reinterpret_cast<unsigned char const*>(output.data()), output.size());
+    }
 }
 
 void
 Pl_ASCIIHexDecoder::finish()
 {
+    output.clear();
     flush();
+    write_output();
     next()->finish();
 }
@@ -3,6 +3,7 @@
 #include <qpdf/QIntC.hh>
 #include <qpdf/Util.hh>
 
+#include <array>
 #include <cstring>
 #include <stdexcept>
 
@@ -26,6 +27,36 @@ to_i(int i)
     return static_cast<int>(i);
 }
 
+namespace
+{
+    constexpr char encode_chars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // The two characters encoding each 12-bit value, so that three bytes are encoded with two
+    // lookups.
+    constexpr auto encode_pairs = [] {
+        std::array<char, 2 * 4096> table{};
+        for (size_t i = 0; i < 4096; ++i) {
+            table[2 * i] = encode_chars[i >> 6];
+            table[2 * i + 1] = encode_chars[i & 0x3f];
+        }
+        return table;
+    }();
+
+    // The value of each character, or 0xff for characters that need to be handled by
+    // flush_decode, such as pad characters, whitespace and invalid characters.
+    constexpr auto decode_values = [] {
+        std::array<unsigned char, 256> table{};
+        table.fill(0xff);
+        for (unsigned char i = 0; i < 64; ++i) {
+            table[static_cast<unsigned char>(encode_chars[i])] = i;
+        }
+        table['-'] = 62;
+        table['_'] = 63;
+        return table;
+    }();
+} // namespace
+
 Pl_Base64::Pl_Base64(char const* identifier, Pipeline* next, action_e action) :
     Pipeline(identifier, next),
     action(action)
@@ -59,13 +90,35 @@ Pl_Base64::decode_internal(std::string_view data)
 {
     auto len = data.size();
     auto res = (len / 4u + 1u) * 3u;
-    out_buffer.reserve(res);
+    auto start = out_buffer.size();
+    out_buffer.resize(start + res);
+    char* out = out_buffer.data() + start;
     unsigned char const* p = reinterpret_cast<const unsigned char*>(data.data());
     while (len > 0) {
+        if (pos == 0 && !end_of_data) {
+            // Decode groups of four characters without padding or whitespace directly.
+            for (; len >= 4; p += 4, len -= 4) {
+                unsigned int a = decode_values[p[0]];
+                unsigned int b = decode_values[p[1]];
+                unsigned int c = decode_values[p[2]];
+                unsigned int d = decode_values[p[3]];
+                if ((a | b | c | d) & 0xc0) {
+                    break;
+                }
+                unsigned int outval = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = to_c(outval >> 16);
+                out[1] = to_c(0xff & (outval >> 8));
+                out[2] = to_c(0xff & outval);
+                out += 3;
+            }
+            if (len == 0) {
+                break;
+            }
+        }
         if (!util::is_space(to_c(*p))) {
             buf[pos++] = *p;
             if (pos == 4) {
-                flush_decode();
+                flush_decode(out);
             }
         }
         ++p;
@@ -75,9 +128,10 @@ Pl_Base64::decode_internal(std::string_view data)
         for (size_t i = pos; i < 4; ++i) {
             buf[i] = '=';
         }
-        flush_decode();
+        flush_decode(out);
     }
-    qpdf_assert_debug(out_buffer.size() <= res);
+    qpdf_assert_debug(out <= out_buffer.data() + start + res);
+    out_buffer.resize(QIntC::to_size(out - out_buffer.data()));
 }
 
 void
@@ -91,24 +145,36 @@ Pl_Base64::encode_internal(std::string_view data)
     }
 
     auto res = (len / 3u + 1u) * 4u;
-    out_buffer.reserve(res);
+    auto start = out_buffer.size();
+    out_buffer.resize(start + res);
+    char* out = out_buffer.data() + start;
     unsigned char const* p = reinterpret_cast<const unsigned char*>(data.data());
+    if (pos == 0) {
+        // Encode complete groups of three bytes directly.
+        for (; len >= 3; p += 3, len -= 3) {
+            unsigned int inval = (p[0] << 16u) | (p[1] << 8u) | p[2];
+            memcpy(out, &encode_pairs[2 * (inval >> 12)], 2);
+            memcpy(out + 2, &encode_pairs[2 * (inval & 0xfff)], 2);
+            out += 4;
+        }
+    }
     while (len > 0) {
         buf[pos++] = *p;
         if (pos == 3) {
-            flush_encode();
+            flush_encode(out);
         }
         ++p;
         --len;
     }
     if (pos > 0) {
-        flush_encode();
+        flush_encode(out);
     }
-    qpdf_assert_debug(out_buffer.size() <= res);
+    qpdf_assert_debug(out <= out_buffer.data() + start + res);
+    out_buffer.resize(QIntC::to_size(out - out_buffer.data()));
 }
 
 void
-Pl_Base64::flush_decode()
+Pl_Base64::flush_decode(char*& out_p)
 {
     if (end_of_data) {
         throw std::runtime_error(getIdentifier() + ": base64 decode: data follows pad characters");
@@ -145,12 +211,13 @@ Pl_Base64::flush_decode()
         to_uc(0xff & outval),
     };
 
-    out_buffer.append(reinterpret_cast<const char*>(out), 3u - pad);
+    memcpy(out_p, out, 3u - pad);
+    out_p += 3u - pad;
     reset();
 }
 
 void
-Pl_Base64::flush_encode()
+Pl_Base64::flush_encode(char*& out_p)
 {
     int outval = ((buf[0] << 16) | (buf[1] << 8) | buf[2]);
     unsigned char out[4] = {
@@ -179,7 +246,8 @@ Pl_Base64::flush_encode()
     for (size_t i = 0; i < 3 - pos; ++i) {
         out[3 - i] = '=';
     }
-    out_buffer.append(reinterpret_cast<const char*>(out), 4);
+    memcpy(out_p, out, 4);
+    out_p += 4;
     reset();
 }
 
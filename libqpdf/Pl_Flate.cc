@@ -1,9 +1,12 @@
 #include <qpdf/Pl_Flate.hh>
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
+#include <memory>
 #include <zlib.h>
 
+#include <qpdf/Pipeline_private.hh>
 #include <qpdf/QIntC.hh>
 #include <qpdf/QUtil.hh>
 #include <qpdf/Util.hh>
@@ -14,11 +17,79 @@
 # include <zopfli.h>
 #endif
 
+#ifdef LIBDEFLATE
+# include <libdeflate.h>
+#endif
+
 using namespace qpdf;
 
 namespace
 {
     static unsigned long long const& memory_limit{global::Limits::flate_max_memory()};
+
+    // libdeflate is used for inflating unless disabled and only used for deflating on request
+    // since its output differs from zlib's.
+    struct LibdeflateSettings
+    {
+        LibdeflateSettings()
+        {
+            std::string value;
+            if (QUtil::get_env("QPDF_LIBDEFLATE", &value)) {
+                inflate = value != "disabled";
+                deflate = value == "deflate";
+            }
+        }
+
+        bool inflate{true};
+        bool deflate{false};
+    };
+
+    LibdeflateSettings&
+    libdeflate_settings()
+    {
+        static LibdeflateSettings settings;
+        return settings;
+    }
+
+#ifdef LIBDEFLATE
+    // Set out to the result of inflating data with libdeflate, starting with an output buffer of
+    // `capacity` bytes and growing it up to `max_size` bytes if max_size is not 0.
+    bool
+    libdeflate_inflate(std::string_view data, std::string& out, size_t capacity, size_t max_size)
+    {
+        thread_local std::unique_ptr<
+            libdeflate_decompressor,
+            decltype(&libdeflate_free_decompressor)>
+            decompressor(libdeflate_alloc_decompressor(), &libdeflate_free_decompressor);
+        if (!decompressor) {
+            return false;
+        }
+        while (true) {
+            if (max_size && capacity > max_size) {
+                capacity = max_size;
+            }
+            out.resize(capacity);
+            size_t out_len = 0;
+            auto result = libdeflate_zlib_decompress_ex(
+                decompressor.get(),
+                data.data(),
+                data.size(),
+                out.data(),
+                capacity,
+                nullptr,
+                &out_len);
+            if (result == LIBDEFLATE_SUCCESS) {
+                out.resize(out_len);
+                return true;
+            }
+            if (result != LIBDEFLATE_INSUFFICIENT_SPACE || (max_size && capacity >= max_size)) {
+                out.clear();
+                return false;
+            }
+            capacity *= 2;
+        }
+    }
+#endif
 } // namespace
 
 int Pl_Flate::compression_level = Z_DEFAULT_COMPRESSION;
@@ -50,6 +121,8 @@ Pl_Flate::Members::Members(size_t out_bufsize, action_e action) :
 
     if (action == a_deflate && Pl_Flate::zopfli_enabled()) {
         zopfli_buf = std::make_unique<std::string>();
+    } else if (action == a_deflate && Pl_Flate::libdeflate_enabled(a_deflate)) {
+        libdeflate_buf = std::make_unique<std::string>();
     }
 }
 
@@ -114,6 +187,10 @@ Pl_Flate::write(unsigned char const* data, size_t len)
         m->zopfli_buf->append(reinterpret_cast<char const*>(data), len);
         return;
     }
+    if (m->libdeflate_buf) {
+        m->libdeflate_buf->append(reinterpret_cast<char const*>(data), len);
+        return;
+    }
 
     // Write in chunks in case len is too big to fit in an int. Assume int is at least 32 bits.
     static size_t const max_bytes = 1 << 30;
@@ -227,6 +304,8 @@ Pl_Flate::finish()
     try {
         if (m->zopfli_buf) {
             finish_zopfli();
+        } else if (m->libdeflate_buf) {
+            finish_libdeflate();
         } else if (m->outbuf.get()) {
             if (m->initialized) {
                 z_stream& zstream = *(static_cast<z_stream*>(m->zdata));
@@ -262,6 +341,12 @@ Pl_Flate::setCompressionLevel(int level)
     compression_level = level;
 }
 
+int
+Pl_Flate::getCompressionLevel()
+{
+    return compression_level;
+}
+
 void
 Pl_Flate::checkError(char const* prefix, int error_code)
 {
@@ -333,6 +418,116 @@ Pl_Flate::finish_zopfli()
 #endif
 }
 
+bool
+pl::inflate(std::string_view data, std::string& out, size_t size_hint, size_t max_size)
+{
+    out.clear();
+    if (data.empty() || data.size() > UINT_MAX) {
+        return false;
+    }
+    if (::memory_limit && (!max_size || max_size > ::memory_limit)) {
+        max_size = static_cast<size_t>(::memory_limit);
+    }
+    size_t capacity = size_hint ? size_hint : 4 * data.size();
+#ifdef LIBDEFLATE
+    if (Pl_Flate::libdeflate_enabled(Pl_Flate::a_inflate)) {
+        return libdeflate_inflate(data, out, capacity, max_size);
+    }
+#endif
+    z_stream zstream{};
+    // inflateInit is a macro that uses an old-style cast.
+#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+    if (inflateInit(&zstream) != Z_OK) {
+        return false;
+    }
+#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
+# pragma GCC diagnostic pop
+#endif
+    zstream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(data.data()));
+    zstream.avail_in = QIntC::to_uint(data.size());
+    size_t produced = 0;
+    int err = Z_OK;
+    while (true) {
+        if (max_size && capacity > max_size) {
+            capacity = max_size;
+        }
+        out.resize(capacity);
+        zstream.next_out = reinterpret_cast<unsigned char*>(out.data() + produced);
+        zstream.avail_out = QIntC::to_uint(std::min(capacity - produced, size_t(UINT_MAX)));
+        auto avail = zstream.avail_out;
+        err = ::inflate(&zstream, Z_FINISH);
+        produced += avail - zstream.avail_out;
+        // Unless the output buffer is full, anything other than the end of the stream means that
+        // the data is damaged or incomplete.
+        if (err == Z_STREAM_END || (err != Z_OK && err != Z_BUF_ERROR) || produced < capacity ||
+            (max_size && capacity >= max_size)) {
+            break;
+        }
+        capacity *= 2;
+    }
+    inflateEnd(&zstream);
+    if (err != Z_STREAM_END) {
+        out.clear();
+        return false;
+    }
+    out.resize(produced);
+    return true;
+}
+
+void
+Pl_Flate::finish_libdeflate()
+{
+#ifdef LIBDEFLATE
+    if (!m->libdeflate_buf) {
+        return;
+    }
+    auto buf = std::move(*m->libdeflate_buf.release());
+    // libdeflate supports levels 0 to 12. zlib's default level is 6.
+    std::unique_ptr<libdeflate_compressor, decltype(&libdeflate_free_compressor)> compressor(
+        libdeflate_alloc_compressor(compression_level < 0 ? 6 : compression_level),
+        &libdeflate_free_compressor);
+    util::no_ci_rt_error_if(
+        !compressor, identifier + ": deflate: libdeflate initialization failed");
+    auto capacity = libdeflate_zlib_compress_bound(compressor.get(), buf.size());
+    auto out = std::make_unique_for_overwrite<unsigned char[]>(capacity);
+    auto out_len =
+        libdeflate_zlib_compress(compressor.get(), buf.data(), buf.size(), out.get(), capacity);
+    util::no_ci_rt_error_if(out_len == 0, identifier + ": deflate: libdeflate compression failed");
+    next()->write(out.get(), out_len);
+    // next()->finish is called by finish()
+#endif
+}
+
+bool
+Pl_Flate::libdeflate_supported()
+{
+#ifdef LIBDEFLATE
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+Pl_Flate::libdeflate_enabled(action_e action)
+{
+    if (!libdeflate_supported()) {
+        return false;
+    }
+    auto const& settings = libdeflate_settings();
+    return action == a_inflate ? settings.inflate : settings.deflate;
+}
+
+void
+Pl_Flate::libdeflate_enabled(action_e action, bool enabled)
+{
+    auto& settings = libdeflate_settings();
+    (action == a_inflate ? settings.inflate : settings.deflate) = enabled;
+}
+
 bool
 Pl_Flate::zopfli_supported()
 {
@@ -1,78 +1,67 @@
 #include <qpdf/Pl_LZWDecoder.hh>
 
-#include <qpdf/QIntC.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/Util.hh>
-#include <cstring>
 #include <stdexcept>
 
 using namespace qpdf;
 
+namespace
+{
+    // Decoded data is passed on when this much has been collected or at the end of each write.
+    constexpr size_t flush_size = 65536;
+} // namespace
+
 Pl_LZWDecoder::Pl_LZWDecoder(char const* identifier, Pipeline* next, bool early_code_change) :
     Pipeline(identifier, next),
     code_change_delta(early_code_change)
 {
     util::assertion(next, "Attempt to create Pl_LZWDecoder with nullptr as next");
+    for (unsigned int i = 0; i < 256; ++i) {
+        auto c = static_cast<unsigned char>(i);
+        table[i].first = c;
+        table[i].last = c;
+    }
 }
 
 void
 Pl_LZWDecoder::write(unsigned char const* bytes, size_t len)
 {
-    for (size_t i = 0; i < len; ++i) {
-        buf[next_char_++] = bytes[i];
-        if (next_char_ == 3) {
-            next_char_ = 0;
-        }
-        bits_available += 8;
-        if (bits_available >= code_size) {
-            sendNextCode();
+    try {
+        for (size_t i = 0; i < len; ++i) {
+            // Codes are packed most significant bit first. Since codes are at least nine bits
+            // long, each byte completes at most one code.
+            bits = (bits << 8) | bytes[i];
+            bits_available += 8;
+            if (bits_available >= code_size) {
+                bits_available -= code_size;
+                auto code = bits >> bits_available;
+                bits &= (1U << bits_available) - 1U;
+                handleCode(code);
+            }
         }
+    } catch (...) {
+        // Pass on what was decoded before the error.
+        flush();
+        throw;
     }
+    flush();
 }
 
 void
 Pl_LZWDecoder::finish()
 {
+    flush();
     next()->finish();
 }
 
 void
-Pl_LZWDecoder::sendNextCode()
+Pl_LZWDecoder::flush()
 {
-    unsigned int high = byte_pos;
-    unsigned int med = (byte_pos + 1) % 3;
-    unsigned int low = (byte_pos + 2) % 3;
-
-    unsigned int bits_from_high = 8 - bit_pos;
-    unsigned int bits_from_med = code_size - bits_from_high;
-    unsigned int bits_from_low = 0;
-    if (bits_from_med > 8) {
-        bits_from_low = bits_from_med - 8;
-        bits_from_med = 8;
-    }
-    unsigned int high_mask = (1U << bits_from_high) - 1U;
-    unsigned int med_mask = 0xff - ((1U << (8 - bits_from_med)) - 1U);
-    unsigned int low_mask = 0xff - ((1U << (8 - bits_from_low)) - 1U);
-    unsigned int code = 0;
-    code += (buf[high] & high_mask) << bits_from_med;
-    code += ((buf[med] & med_mask) >> (8 - bits_from_med));
-    if (bits_from_low) {
-        code <<= bits_from_low;
-        code += ((buf[low] & low_mask) >> (8 - bits_from_low));
-        byte_pos = low;
-        bit_pos = bits_from_low;
-    } else {
-        byte_pos = med;
-        bit_pos = bits_from_med;
-    }
-    if (bit_pos == 8) {
-        bit_pos = 0;
-        ++byte_pos;
-        byte_pos %= 3;
+    if (!output.empty()) {
+        next()->write(reinterpret_cast<unsigned char const*>(output.data()), output.size());
+        output.clear();
     }
-    bits_available -= code_size;
-
-    handleCode(code);
 }
 
 unsigned char
@@ -84,41 +73,30 @@ Pl_LZWDecoder::getFirstChar(unsigned int code)
     util::no_ci_rt_error_if(
         code <= 257,
         "Pl_LZWDecoder::getFirstChar called with invalid code (" + std::to_string(code) + ")");
-
-    unsigned int idx = code - 258;
-    util::no_ci_rt_error_if(idx >= table.size(), "Pl_LZWDecoder::getFirstChar: table overflow");
-    Buffer& b = table.at(idx);
-    return b.getBuffer()[0];
+    util::no_ci_rt_error_if(
+        code - 258 >= table_size, "Pl_LZWDecoder::getFirstChar: table overflow");
+    return table[code].first;
 }
 
 void
 Pl_LZWDecoder::addToTable(unsigned char c)
 {
-    unsigned int last_size = 0;
-    unsigned char const* last_data = nullptr;
-    unsigned char tmp[1];
-
-    if (last_code < 256) {
-        tmp[0] = static_cast<unsigned char>(last_code);
-        last_data = tmp;
-        last_size = 1;
-    } else {
+    if (last_code >= 256) {
         util::no_ci_rt_error_if(
             last_code <= 257,
             "Pl_LZWDecoder::addToTable called with invalid code (" + std::to_string(last_code) +
                 ")");
-        unsigned int idx = last_code - 258;
-        util::no_ci_rt_error_if(idx >= table.size(), "Pl_LZWDecoder::addToTable: table overflow");
-        Buffer& b = table.at(idx);
-        last_data = b.getBuffer();
-        last_size = QIntC::to_uint(b.getSize());
+        util::no_ci_rt_error_if(
+            last_code - 258 >= table_size, "Pl_LZWDecoder::addToTable: table overflow");
     }
 
-    Buffer entry(1 + last_size);
-    unsigned char* new_data = entry.getBuffer();
-    memcpy(new_data, last_data, last_size);
-    new_data[last_size] = c;
-    table.push_back(std::move(entry));
+    auto const& prefix = table[last_code];
+    auto& entry = table[258 + table_size];
+    entry.prefix = static_cast<std::uint16_t>(last_code);
+    entry.length = static_cast<std::uint16_t>(prefix.length + 1);
+    entry.first = prefix.first;
+    entry.last = c;
+    ++table_size;
 }
 
 void
@@ -129,10 +107,10 @@ Pl_LZWDecoder::handleCode(unsigned int code)
     }
 
     if (code == 256) {
-        if (!table.empty()) {
+        if (table_size > 0) {
             QTC::TC("libtests", "Pl_LZWDecoder intermediate reset");
         }
-        table.clear();
+        table_size = 0;
         code_size = 9;
     } else if (code == 257) {
         eod = true;
@@ -141,7 +119,6 @@ Pl_LZWDecoder::handleCode(unsigned int code)
             // Add to the table from last time.  New table entry would be what we read last plus the
             // first character of what we're reading now.
             unsigned char next_c = '\0';
-            unsigned int table_size = QIntC::to_uint(table.size());
             if (code < 256) {
                 // just read < 256; last time's next_c was code
                 next_c = static_cast<unsigned char>(code);
@@ -167,15 +144,23 @@ Pl_LZWDecoder::handleCode(unsigned int code)
         }
 
         if (code < 256) {
-            auto ch = static_cast<unsigned char>(code);
-            next()->write(&ch, 1);
+            output += static_cast<char>(code);
         } else {
-            unsigned int idx = code - 258;
-            if (idx >= table.size()) {
+            if (code - 258 >= table_size) {
                 throw std::runtime_error("Pl_LZWDecoder::handleCode: table overflow");
             }
-            Buffer& b = table.at(idx);
-            next()->write(b.getBuffer(), b.getSize());
+            // Follow the chain of prefixes from the last character to the first, filling in the
+            // decoded string from the back.
+            auto length = table[code].length;
+            auto start = output.size();
+            output.resize(start + length);
+            auto* p = output.data() + start + length;
+            for (auto c = code; p != output.data() + start; c = table[c].prefix) {
+                *--p = static_cast<char>(table[c].last);
+            }
+        }
+        if (output.size() >= flush_size) {
+            flush();
         }
     }
 
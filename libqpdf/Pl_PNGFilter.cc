@@ -4,21 +4,155 @@
 #include <qpdf/Util.hh>
 #include <qpdf/global_private.hh>
 
+#include <algorithm>
 #include <climits>
+#include <cstdlib>
 #include <cstring>
+#include <type_traits>
 
 using namespace qpdf;
 
 namespace
 {
     unsigned long long const& memory_limit = global::Limits::png_max_memory();
-} // namespace
 
-static int
-abs_diff(int a, int b)
-{
-    return a > b ? a - b : b - a;
-}
+    // Rows are passed to the next pipeline once this much output has been collected.
+    constexpr size_t flush_size = 65536;
+
+    // Up prediction is done on eight bytes at a time by treating them as a 64-bit word and masking
+    // out the carries between bytes.
+    constexpr uint64_t high_bits = 0x8080808080808080ULL;
+
+    inline uint64_t
+    load(unsigned char const* p)
+    {
+        uint64_t result;
+        memcpy(&result, p, sizeof(result));
+        return result;
+    }
+
+    inline void
+    store(unsigned char* p, uint64_t value)
+    {
+        memcpy(p, &value, sizeof(value));
+    }
+
+    // row[i] += prev[i]
+    void
+    decode_up(unsigned char* row, unsigned char const* prev, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            auto x = load(row + i);
+            auto y = load(prev + i);
+            store(row + i, ((x & ~high_bits) + (y & ~high_bits)) ^ ((x ^ y) & high_bits));
+        }
+        for (; i < n; ++i) {
+            row[i] = static_cast<unsigned char>(row[i] + prev[i]);
+        }
+    }
+
+    // out[i] = row[i] - prev[i]
+    void
+    encode_up(unsigned char* out, unsigned char const* row, unsigned char const* prev, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            auto x = load(row + i);
+            auto y = load(prev + i);
+            store(out + i, ((x | high_bits) - (y & ~high_bits)) ^ ((x ^ ~y) & high_bits));
+        }
+        for (; i < n; ++i) {
+            out[i] = static_cast<unsigned char>(row[i] - prev[i]);
+        }
+    }
+
+    // The remaining decoders depend on the previous pixel. They take the number of bytes per pixel
+    // as a template parameter for the common cases so that the loops have a fixed stride, which
+    // lets the compiler keep the previous pixel in registers. A template parameter of 0 handles
+    // any number of bytes per pixel.
+    template <size_t BPP>
+    void
+    decode_sub(unsigned char* row, size_t n, size_t bpp)
+    {
+        size_t const step = BPP ? BPP : bpp;
+        for (size_t i = step; i < n; ++i) {
+            row[i] = static_cast<unsigned char>(row[i] + row[i - step]);
+        }
+    }
+
+    template <size_t BPP>
+    void
+    decode_average(unsigned char* row, unsigned char const* prev, size_t n, size_t bpp)
+    {
+        size_t const step = BPP ? BPP : bpp;
+        size_t const first = std::min(step, n);
+        for (size_t i = 0; i < first; ++i) {
+            row[i] = static_cast<unsigned char>(row[i] + prev[i] / 2);
+        }
+        for (size_t i = step; i < n; ++i) {
+            row[i] = static_cast<unsigned char>(row[i] + (row[i - step] + prev[i]) / 2);
+        }
+    }
+
+    // This is the Paeth predictor from the PNG specification with p = a + b - c substituted into
+    // the distances, which avoids branches other than the final selection.
+    inline int
+    paeth(int a, int b, int c)
+    {
+        int pa = std::abs(b - c);
+        int pb = std::abs(a - c);
+        int pc = std::abs(a + b - 2 * c);
+        return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+    }
+
+    template <size_t BPP>
+    void
+    decode_paeth(unsigned char* row, unsigned char const* prev, size_t n, size_t bpp)
+    {
+        size_t const step = BPP ? BPP : bpp;
+        size_t const first = std::min(step, n);
+        // For the first pixel, the left and upper left bytes are 0, so the predictor is up.
+        for (size_t i = 0; i < first; ++i) {
+            row[i] = static_cast<unsigned char>(row[i] + prev[i]);
+        }
+        for (size_t i = step; i < n; ++i) {
+            row[i] = static_cast<unsigned char>(
+                row[i] + paeth(row[i - step], prev[i], prev[i - step]));
+        }
+    }
+
+    // Call f with std::integral_constant<size_t, N> where N is bpp for the specialized cases and 0
+    // otherwise.
+    template <typename F>
+    void
+    with_bpp(size_t bpp, F&& f)
+    {
+        switch (bpp) {
+        case 1:
+            f(std::integral_constant<size_t, 1>());
+            break;
+        case 2:
+            f(std::integral_constant<size_t, 2>());
+            break;
+        case 3:
+            f(std::integral_constant<size_t, 3>());
+            break;
+        case 4:
+            f(std::integral_constant<size_t, 4>());
+            break;
+        case 6:
+            f(std::integral_constant<size_t, 6>());
+            break;
+        case 8:
+            f(std::integral_constant<size_t, 8>());
+            break;
+        default:
+            f(std::integral_constant<size_t, 0>());
+            break;
+        }
+    }
+} // namespace
 
 Pl_PNGFilter::Pl_PNGFilter(
     char const* identifier,
@@ -78,11 +212,11 @@ Pl_PNGFilter::write(unsigned char const* data, size_t len)
 
         processRow();
 
-        // Swap rows
+        // Swap rows. The new current row is overwritten before it is used except when finish()
+        // processes a partial row, which clears the rest of the row first.
         unsigned char* t = prev_row;
         prev_row = cur_row;
         cur_row = t ? t : buf2.get();
-        memset(cur_row, 0, bytes_per_row + 1);
         left = incoming;
         pos = 0;
     }
@@ -90,6 +224,16 @@ Pl_PNGFilter::write(unsigned char const* data, size_t len)
         memcpy(cur_row + pos, data + offset, len);
     }
     pos += len;
+    flush();
+}
+
+void
+Pl_PNGFilter::flush()
+{
+    if (!output.empty()) {
+        next()->write(reinterpret_cast<unsigned char const*>(output.data()), output.size());
+        output.clear();
+    }
 }
 
 void
@@ -128,109 +272,70 @@ Pl_PNGFilter::decodeRow()
         }
     }
 
-    next()->write(cur_row + 1, bytes_per_row);
+    if (bytes_per_row >= flush_size) {
+        // Pass large rows on directly so that the collected output stays small.
+        flush();
+        next()->write(cur_row + 1, bytes_per_row);
+        return;
+    }
+    output.append(reinterpret_cast<char const*>(cur_row + 1), bytes_per_row);
+    if (output.size() >= flush_size) {
+        flush();
+    }
 }
 
 void
 Pl_PNGFilter::decodeSub()
 {
-    unsigned char* buffer = cur_row + 1;
-    unsigned int bpp = bytes_per_pixel;
-
-    for (unsigned int i = 0; i < bytes_per_row; ++i) {
-        unsigned char left = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-        }
-
-        buffer[i] = static_cast<unsigned char>(buffer[i] + left);
-    }
+    with_bpp(bytes_per_pixel, [this](auto bpp) {
+        decode_sub<decltype(bpp)::value>(cur_row + 1, bytes_per_row, bytes_per_pixel);
+    });
 }
 
 void
 Pl_PNGFilter::decodeUp()
 {
-    unsigned char* buffer = cur_row + 1;
-    unsigned char* above_buffer = prev_row + 1;
-
-    for (unsigned int i = 0; i < bytes_per_row; ++i) {
-        unsigned char up = above_buffer[i];
-        buffer[i] = static_cast<unsigned char>(buffer[i] + up);
-    }
+    decode_up(cur_row + 1, prev_row + 1, bytes_per_row);
 }
 
 void
 Pl_PNGFilter::decodeAverage()
 {
-    unsigned char* buffer = cur_row + 1;
-    unsigned char* above_buffer = prev_row + 1;
-    auto bpp = bytes_per_pixel;
-
-    for (unsigned int i = 0; i < bytes_per_row; ++i) {
-        int left = 0;
-        int up = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-        }
-
-        up = above_buffer[i];
-        buffer[i] = static_cast<unsigned char>(buffer[i] + (left + up) / 2);
-    }
+    with_bpp(bytes_per_pixel, [this](auto bpp) {
+        decode_average<decltype(bpp)::value>(
+            cur_row + 1, prev_row + 1, bytes_per_row, bytes_per_pixel);
+    });
 }
 
 void
 Pl_PNGFilter::decodePaeth()
 {
-    unsigned char* buffer = cur_row + 1;
-    unsigned char* above_buffer = prev_row + 1;
-    auto bpp = bytes_per_pixel;
-
-    for (unsigned int i = 0; i < bytes_per_row; ++i) {
-        int left = 0;
-        int up = above_buffer[i];
-        int upper_left = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-            upper_left = above_buffer[i - bpp];
-        }
-
-        buffer[i] = static_cast<unsigned char>(buffer[i] + PaethPredictor(left, up, upper_left));
-    }
-}
-
-int
-Pl_PNGFilter::PaethPredictor(int a, int b, int c)
-{
-    int p = a + b - c;
-    int pa = abs_diff(p, a);
-    int pb = abs_diff(p, b);
-    int pc = abs_diff(p, c);
-
-    if (pa <= pb && pa <= pc) {
-        return a;
-    }
-    if (pb <= pc) {
-        return b;
-    }
-    return c;
+    with_bpp(bytes_per_pixel, [this](auto bpp) {
+        decode_paeth<decltype(bpp)::value>(
+            cur_row + 1, prev_row + 1, bytes_per_row, bytes_per_pixel);
+    });
 }
 
 void
 Pl_PNGFilter::encodeRow()
 {
     // For now, hard-code to using UP filter.
-    unsigned char ch = 2;
-    next()->write(&ch, 1);
-    if (prev_row) {
-        for (unsigned int i = 0; i < bytes_per_row; ++i) {
-            ch = static_cast<unsigned char>(cur_row[i] - prev_row[i]);
-            next()->write(&ch, 1);
+    output += '\2';
+    // Encode large rows in pieces so that the collected output stays small.
+    for (size_t done = 0; done < bytes_per_row;) {
+        auto n = std::min(flush_size, bytes_per_row - done);
+        auto old_size = output.size();
+        output.resize(old_size + n);
+        auto out = reinterpret_cast<unsigned char*>(output.data() + old_size);
+        if (prev_row) {
+            encode_up(out, cur_row + done, prev_row + done, n);
+        } else {
+            memcpy(out, cur_row + done, n);
+        }
+        done += n;
+        if (output.size() >= flush_size) {
+            flush();
         }
-    } else {
-        next()->write(cur_row, bytes_per_row);
     }
 }
 
@@ -239,8 +344,10 @@ Pl_PNGFilter::finish()
 {
     if (pos) {
         // write partial row
+        memset(cur_row + pos, 0, incoming - pos);
         processRow();
     }
+    flush();
     prev_row = nullptr;
     cur_row = buf1.get();
     pos = 0;
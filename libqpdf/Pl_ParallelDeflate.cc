@@ -0,0 +1,159 @@
+#include <qpdf/Pl_ParallelDeflate.hh>
+
+#include <qpdf/Pl_Flate.hh>
+#include <qpdf/QIntC.hh>
+#include <qpdf/Util.hh>
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace qpdf;
+using namespace std::literals;
+
+namespace
+{
+    // The deflate window size, which is also the largest useful preset dictionary.
+    constexpr size_t window_size = 1 << MAX_WBITS;
+} // namespace
+
+Pl_ParallelDeflate::Pl_ParallelDeflate(
+    char const* identifier, Pipeline* next, WorkerPool& workers, size_t block_size) :
+    Pipeline(identifier, next),
+    workers(workers),
+    block_size(std::max(block_size, size_t(1))),
+    level(Pl_Flate::getCompressionLevel())
+{
+    util::assertion(next, "Attempt to create Pl_ParallelDeflate with nullptr as next");
+    util::no_ci_rt_error_if(
+        block_size > UINT_MAX,
+        "Pl_ParallelDeflate: zlib doesn't support blocks larger than unsigned int");
+}
+
+void
+Pl_ParallelDeflate::write(unsigned char const* data, size_t len)
+{
+    while (len > 0) {
+        auto n = std::min(len, block_size - block.size());
+        block.append(reinterpret_cast<char const*>(data), n);
+        data += n;
+        len -= n;
+        if (block.size() == block_size) {
+            dispatch(false);
+        }
+    }
+}
+
+void
+Pl_ParallelDeflate::finish()
+{
+    dispatch(true);
+    drain(0);
+    unsigned char trailer[4];
+    for (int i = 3; i >= 0; --i) {
+        trailer[i] = static_cast<unsigned char>(adler & 0xff);
+        adler >>= 8;
+    }
+    next()->write(trailer, sizeof(trailer));
+    adler = 1;
+    header_written = false;
+    dictionary.clear();
+    next()->finish();
+}
+
+void
+Pl_ParallelDeflate::dispatch(bool last)
+{
+    // The dictionary for the next block is the end of the data seen so far.
+    std::string next_dictionary;
+    if (block.size() >= window_size) {
+        next_dictionary = block.substr(block.size() - window_size);
+    } else {
+        next_dictionary = dictionary + block;
+        if (next_dictionary.size() > window_size) {
+            next_dictionary.erase(0, next_dictionary.size() - window_size);
+        }
+    }
+    pending.emplace_back(workers.submit(
+        [data = std::move(block), dict = std::move(dictionary), level = level, last]() mutable {
+            return compress(std::move(data), std::move(dict), level, last);
+        }));
+    block = std::string();
+    dictionary = std::move(next_dictionary);
+    // Limit the number of blocks held in memory.
+    drain(2 * workers.size());
+}
+
+void
+Pl_ParallelDeflate::drain(size_t max_pending)
+{
+    while (pending.size() > max_pending) {
+        auto b = pending.front().get();
+        pending.pop_front();
+        if (!header_written) {
+            // Write the zlib header deflateInit would write for a 32 KiB window and no preset
+            // dictionary.
+            int l = level < 0 ? 6 : level;
+            unsigned int header = (0x78 << 8) | ((l < 2 ? 0 : l < 6 ? 1 : l == 6 ? 2 : 3) << 6);
+            header += 31 - (header % 31);
+            unsigned char bytes[2] = {
+                static_cast<unsigned char>(header >> 8), static_cast<unsigned char>(header & 0xff)};
+            next()->write(bytes, sizeof(bytes));
+            header_written = true;
+        }
+        next()->write(reinterpret_cast<unsigned char const*>(b.data.data()), b.data.size());
+        adler = adler32_combine(adler, b.adler, QIntC::to_offset(b.size));
+    }
+}
+
+Pl_ParallelDeflate::Block
+Pl_ParallelDeflate::compress(std::string data, std::string dictionary, int level, bool last)
+{
+    z_stream zstream{};
+    auto check = [&zstream](int code, char const* prefix) {
+        if (code != Z_OK) {
+            throw std::runtime_error(
+                "parallel deflate: "s + prefix + ": " +
+                (zstream.msg ? zstream.msg : "zlib error " + std::to_string(code)));
+        }
+    };
+    check(deflateInit2(&zstream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY), "init");
+    std::unique_ptr<z_stream, int (*)(z_streamp)> guard(&zstream, deflateEnd);
+    if (!dictionary.empty()) {
+        check(
+            deflateSetDictionary(
+                &zstream,
+                reinterpret_cast<Bytef const*>(dictionary.data()),
+                QIntC::to_uint(dictionary.size())),
+            "set dictionary");
+    }
+
+    Block result;
+    result.size = data.size();
+    result.adler = adler32(
+        1, reinterpret_cast<Bytef const*>(data.data()), QIntC::to_uint(data.size()));
+    zstream.next_in = reinterpret_cast<Bytef*>(data.data());
+    zstream.avail_in = QIntC::to_uint(data.size());
+    // Blocks other than the last end with a sync flush, which ends the block on a byte boundary
+    // without ending the deflate stream.
+    int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    result.data.resize(deflateBound(&zstream, zstream.avail_in) + 16);
+    size_t done = 0;
+    while (true) {
+        zstream.next_out = reinterpret_cast<Bytef*>(result.data.data() + done);
+        zstream.avail_out = QIntC::to_uint(result.data.size() - done);
+        int code = deflate(&zstream, flush);
+        done = result.data.size() - zstream.avail_out;
+        if (code == Z_STREAM_END || (!last && code == Z_OK && zstream.avail_out > 0)) {
+            break;
+        }
+        if (code != Z_BUF_ERROR) {
+            check(code, "deflate");
+        }
+        result.data.resize(2 * result.data.size());
+    }
+    result.data.resize(done);
+    return result;
+}
@@ -14,6 +14,7 @@
 #include <qpdf/AcroForm.hh>
 #include <qpdf/FileInputSource.hh>
 #include <qpdf/InputSource_private.hh>
+#include <qpdf/MmapInputSource.hh>
 #include <qpdf/OffsetInputSource.hh>
 #include <qpdf/Pipeline.hh>
 #include <qpdf/QPDFExc.hh>
@@ -211,8 +212,7 @@ QPDF::create()
 void
 QPDF::processFile(char const* filename, char const* password)
 {
-    auto* fi = new FileInputSource(filename);
-    processInputSource(std::shared_ptr<InputSource>(fi), password);
+    processInputSource(MmapInputSource::create(filename), password);
 }
 
 void
@@ -312,6 +312,12 @@ QPDF::setImmediateCopyFrom(bool val)
     (void)m->cf.immediate_copy_from(val);
 }
 
+void
+QPDF::setLazyArrays(bool val)
+{
+    (void)m->cf.lazy_arrays(val);
+}
+
 std::vector<QPDFExc>
 QPDF::getWarnings()
 {
@@ -341,6 +347,10 @@ QPDF::warn(QPDFExc const& e)
 void
 Common::warn(QPDFExc const& e)
 {
+    if (m->held_warnings) {
+        m->held_warnings->emplace_back(e);
+        return;
+    }
     if (cf.max_warnings() > 0 && m->warnings.size() >= cf.max_warnings()) {
         stopOnError("Too many warnings - file is too badly damaged");
     }
@@ -687,10 +697,10 @@ QPDF::getRoot()
 std::map<QPDFObjGen, QPDFXRefEntry>
 QPDF::getXRefTable()
 {
-    return m->objects.xref_table();
+    return m->objects.xref_table().map();
 }
 
-std::map<QPDFObjGen, QPDFXRefEntry> const&
+ObjGenMap<QPDFXRefEntry> const&
 Objects::xref_table()
 {
     util::assertion(m->parsed, "QPDF::getXRefTable called before parsing");
@@ -717,17 +727,39 @@ QPDF::pipeStreamData(
             encp, file, qpdf_for_warning, pipeline, og, stream_dict, is_root_metadata, to_delete);
     }
 
+    return Streams::pipe_data(
+        qpdf_for_warning, *file, og, pipeline, suppress_warnings, will_retry, [&]() {
+            // If the input is held in memory, pass the data to the pipeline without copying it.
+            std::string buf;
+            auto data = is::view(*file, length, offset);
+            if (!data) {
+                file->read(buf, length, offset);
+                data = buf;
+            }
+            if (data->size() != length) {
+                throw qpdf_for_warning.m->c.damagedPDF(
+                    *file,
+                    "",
+                    offset + QIntC::to_offset(data->size()),
+                    "unexpected EOF reading stream data");
+            }
+            pipeline->write(data->data(), length);
+        });
+}
+
+bool
+Streams::pipe_data(
+    QPDF& qpdf_for_warning,
+    InputSource& file,
+    QPDFObjGen og,
+    Pipeline* pipeline,
+    bool suppress_warnings,
+    bool will_retry,
+    std::function<void()> const& write)
+{
     bool attempted_finish = false;
     try {
-        auto buf = file->read(length, offset);
-        if (buf.size() != length) {
-            throw qpdf_for_warning.m->c.damagedPDF(
-                *file,
-                "",
-                offset + QIntC::to_offset(buf.size()),
-                "unexpected EOF reading stream data");
-        }
-        pipeline->write(buf.data(), length);
+        write();
         attempted_finish = true;
         pipeline->finish();
         return true;
@@ -741,18 +773,18 @@ QPDF::pipeStreamData(
             qpdf_for_warning.warn(
                 // line-break
                 qpdf_for_warning.m->c.damagedPDF(
-                    *file,
+                    file,
                     "",
-                    file->getLastOffset(),
+                    file.getLastOffset(),
                     ("error decoding stream data for object " + og.unparse(' ') + ": " +
                      e.what())));
             if (will_retry) {
                 qpdf_for_warning.warn(
                     // line-break
                     qpdf_for_warning.m->c.damagedPDF(
-                        *file,
+                        file,
                         "",
-                        file->getLastOffset(),
+                        file.getLastOffset(),
                         "stream will be re-processed without filtering to avoid data loss"));
             }
         }
@@ -767,6 +799,18 @@ QPDF::pipeStreamData(
     return false;
 }
 
+bool
+Streams::pipe_data(
+    QPDF* qpdf,
+    QPDFObjGen og,
+    Pipeline* pipeline,
+    bool suppress_warnings,
+    bool will_retry,
+    std::function<void()> const& write)
+{
+    return pipe_data(*qpdf, *qpdf->m->file, og, pipeline, suppress_warnings, will_retry, write);
+}
+
 bool
 QPDF::pipeStreamData(
     QPDFObjGen og,
@@ -6,7 +6,7 @@
 
 #include <qpdf/AcroForm.hh>
 #include <qpdf/ClosedFileInputSource.hh>
-#include <qpdf/FileInputSource.hh>
+#include <qpdf/MmapInputSource.hh>
 #include <qpdf/Pipeline_private.hh>
 #include <qpdf/Pl_DCT.hh>
 #include <qpdf/Pl_Discard.hh>
@@ -2397,10 +2397,7 @@ QPDFJob::Inputs::process(QPDFJob& job, std::string const& filename, QPDFJob::Inp
         job.processInputSource(input.qpdf_p, cis, password.data(), true);
     } else {
         job.processInputSource(
-            input.qpdf_p,
-            std::make_shared<FileInputSource>(filename.data()),
-            password.data(),
-            true);
+            input.qpdf_p, MmapInputSource::create(filename), password.data(), true);
     }
     input.initialize(job, *this);
 
@@ -182,6 +182,22 @@ QPDFJob::Config::compressionLevel(std::string const& parameter)
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::compressionThreads(std::string const& parameter)
+{
+    o.m->w_cfg.compression_threads(
+        QIntC::to_size(to_int("compression-threads", parameter, 256, 0)));
+    return this;
+}
+
+QPDFJob::Config*
+QPDFJob::Config::deflateBlockSize(std::string const& parameter)
+{
+    o.m->w_cfg.deflate_block_size(
+        1024 * QIntC::to_size(to_int("deflate-block-size", parameter, 1 << 20, 0)));
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::jpegQuality(std::string const& parameter)
 {
@@ -263,14 +263,15 @@ BaseHandle::copy(bool shallow) const
     case ::ot_integer:
         return QPDFObject::create<QPDF_Integer>(std::get<QPDF_Integer>(obj->value).val);
     case ::ot_real:
-        return QPDFObject::create<QPDF_Real>(std::get<QPDF_Real>(obj->value).val);
+        return QPDFObject::create<QPDF_Real>(std::get<QPDF_Real>(obj->value));
     case ::ot_string:
         return QPDFObject::create<QPDF_String>(std::get<QPDF_String>(obj->value).val);
     case ::ot_name:
         return QPDFObject::create<QPDF_Name>(std::get<QPDF_Name>(obj->value).name);
     case ::ot_array:
         {
-            auto const& a = std::get<QPDF_Array>(obj->value);
+            auto& a = std::get<QPDF_Array>(obj->value);
+            a.materialize();
             if (shallow) {
                 return QPDFObject::create<QPDF_Array>(a);
             } else {
@@ -388,8 +389,10 @@ BaseHandle::equivalent_to(BaseHandle const& other, int depth) const
         return std::get<QPDF_Name>(obj->value).name == std::get<QPDF_Name>(other.obj->value).name;
     case ::ot_array:
         {
-            auto const& a1 = std::get<QPDF_Array>(obj->value);
-            auto const& a2 = std::get<QPDF_Array>(other.obj->value);
+            auto& a1 = std::get<QPDF_Array>(obj->value);
+            auto& a2 = std::get<QPDF_Array>(other.obj->value);
+            a1.materialize();
+            a2.materialize();
             // sizes size1, size2 were calculated above and checked to be equal
             if (!a1.sp && !a2.sp) {
                 for (size_t i = 0; i < size1; ++i) {
@@ -486,14 +489,15 @@ BaseHandle::unparse() const
     case ::ot_integer:
         return std::to_string(std::get<QPDF_Integer>(obj->value).val);
     case ::ot_real:
-        return std::get<QPDF_Real>(obj->value).val;
+        return std::get<QPDF_Real>(obj->value).text();
     case ::ot_string:
         return std::get<QPDF_String>(obj->value).unparse(false);
     case ::ot_name:
         return Name::normalize(std::get<QPDF_Name>(obj->value).name);
     case ::ot_array:
         {
-            auto const& a = std::get<QPDF_Array>(obj->value);
+            auto& a = std::get<QPDF_Array>(obj->value);
+            a.materialize();
             std::string result = "[ ";
             if (a.sp) {
                 size_t next = 0;
@@ -566,7 +570,7 @@ BaseHandle::write_json(int json_version, JSON::Writer& p) const
         break;
     case ::ot_real:
         {
-            auto const& val = std::get<QPDF_Real>(obj->value).val;
+            auto val = std::get<QPDF_Real>(obj->value).text();
             if (val.empty()) {
                 // Can't really happen...
                 p << "0";
@@ -607,7 +611,8 @@ BaseHandle::write_json(int json_version, JSON::Writer& p) const
         break;
     case ::ot_array:
         {
-            auto const& a = std::get<QPDF_Array>(obj->value);
+            auto& a = std::get<QPDF_Array>(obj->value);
+            a.materialize();
             p.writeStart('[');
             if (a.sp) {
                 size_t next = 0;
@@ -653,7 +658,7 @@ BaseHandle::write_json(int json_version, JSON::Writer& p) const
                           << "\": ";
                     } else if (auto res = Name::analyzeJSONEncoding(iter.first); res.first) {
                         if (res.second) {
-                            p << "\"" << iter.first << "\": ";
+                            p << "\"" << iter.first.name() << "\": ";
                         } else {
                             p << "\"" << JSON::Writer::encode_string(iter.first) << "\": ";
                         }
@@ -691,6 +696,8 @@ BaseHandle::disconnect(bool only_direct)
         {
             auto& a = std::get<QPDF_Array>(obj->value);
             if (a.sp) {
+                // Elements of lazily read arrays that are parsed after the QPDF has been destroyed
+                // are created disconnected.
                 for (auto& item: a.sp->elements) {
                     item.second.disconnect();
                 }
@@ -812,8 +819,8 @@ QPDFObjectHandle::getNumericValue() const
 {
     if (isInteger()) {
         return static_cast<double>(getIntValue());
-    } else if (isReal()) {
-        return atof(getRealValue().c_str());
+    } else if (auto* real = as<QPDF_Real>()) {
+        return real->value();
     } else {
         typeWarning("number", "returning 0");
         QTC::TC("qpdf", "QPDFObjectHandle numeric non-numeric");
@@ -1045,7 +1052,7 @@ std::string
 QPDFObjectHandle::getRealValue() const
 {
     if (auto* real = as<QPDF_Real>()) {
-        return real->val;
+        return real->text();
     }
     typeWarning("real", "returning 0.0");
     return "0.0";
@@ -1055,7 +1062,7 @@ bool
 QPDFObjectHandle::getValueAsReal(std::string& value) const
 {
     if (auto* real = as<QPDF_Real>()) {
-        value = real->val;
+        value = real->text();
         return true;
     }
     return false;
@@ -1362,7 +1369,7 @@ QPDFObjectHandle::mergeResources(
                         } else {
                             QTC::TC("qpdf", "QPDFObjectHandle merge generate");
                             std::string new_key =
-                                getUniqueResourceName(key + "_", min_suffix, &rnames);
+                                getUniqueResourceName(key.name() + "_", min_suffix, &rnames);
                             (*conflicts)[rtype][key] = new_key;
                             this_val.replaceKey(new_key, rval);
                         }
@@ -8,6 +8,7 @@
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
 
+#include <limits>
 #include <memory>
 
 using namespace std::literals;
@@ -127,18 +128,21 @@ Parser::parse(
     QPDF& context,
     bool sanity_checks)
 {
-    return Parser(
-               input,
-               make_description(input.getName(), object_description),
-               object_description,
-               tokenizer,
-               decrypter,
-               &context,
-               true,
-               0,
-               0,
-               sanity_checks)
-        .parse();
+    auto p = Parser(
+        input,
+        make_description(input.getName(), object_description),
+        object_description,
+        tokenizer,
+        decrypter,
+        &context,
+        true,
+        0,
+        0,
+        sanity_checks);
+    if (!decrypter && !sanity_checks) {
+        p.lazy_ = context.doc().objects().lazy_source(input);
+    }
+    return p.parse();
 }
 
 QPDFObjectHandle
@@ -159,6 +163,45 @@ Parser::parse(
         .parse();
 }
 
+QPDFObjectHandle
+Parser::parse_lazy(LazyElements const& lazy, size_t n)
+{
+    auto const& element = lazy.elements.at(n);
+    auto qpdf = lazy.source->qpdf;
+    auto description = lazy.description;
+    switch (element.kind) {
+    case LazyElements::k_reference:
+        if (!qpdf) {
+            return {QPDFObject::create<QPDF_Destroyed>()};
+        }
+        return {ParseGuard::getObject(qpdf, QIntC::to_int(element.value), element.gen, true)};
+
+    case LazyElements::k_integer:
+        {
+            auto obj = QPDFObject::create<QPDF_Integer>(element.value);
+            obj->setDescription(qpdf, description, element.offset);
+            return {obj};
+        }
+
+    default:
+        {
+            // Re-read the element with a parser of its own, leaving the input where we found it.
+            static const std::string empty;
+            auto& input = *lazy.source->input;
+            auto position = input.tell();
+            qpdf::Tokenizer tokenizer;
+            input.seek(element.offset, SEEK_SET);
+            auto result =
+                Parser(input, description, empty, tokenizer, nullptr, qpdf, true).parse();
+            input.seek(position, SEEK_SET);
+            if (result) {
+                return result;
+            }
+            return {QPDFObject::create<QPDF_Null>()};
+        }
+    }
+}
+
 QPDFObjectHandle
 Parser::parse(bool content_stream)
 {
@@ -217,6 +260,10 @@ Parser::parse_first(bool content_stream)
         return {};
 
     case QPDFTokenizer::tt_array_open:
+        if (auto object = lazy_array()) {
+            return {object};
+        }
+        [[fallthrough]];
     case QPDFTokenizer::tt_dict_open:
         stack_.clear();
         stack_.emplace_back(
@@ -232,7 +279,7 @@ Parser::parse_first(bool content_stream)
         return {QPDFObject::create<QPDF_Null>()};
 
     case QPDFTokenizer::tt_integer:
-        return with_description<QPDF_Integer>(QUtil::string_to_ll(tokenizer_.getValue().c_str()));
+        return with_description<QPDF_Integer>(tokenizer_.getIntValue());
 
     case QPDFTokenizer::tt_real:
         return with_description<QPDF_Real>(tokenizer_.getValue());
@@ -303,7 +350,7 @@ Parser::parse_remainder(bool content_stream)
                     add_int(int_count_);
                 }
                 last_offset_buffer_[int_count_ % 2] = input_.getLastOffset();
-                int_buffer_[int_count_ % 2] = QUtil::string_to_ll(tokenizer_.getValue().c_str());
+                int_buffer_[int_count_ % 2] = tokenizer_.getIntValue();
                 continue;
 
             } else if (
@@ -405,10 +452,12 @@ Parser::parse_remainder(bool content_stream)
                 }
 
                 if (!frame_->contents_string.empty() && dict.contains("/Type") &&
-                    dict["/Type"].isNameAndEquals("/Sig") && dict.contains("/ByteRange") &&
-                    dict.contains("/Contents") && dict["/Contents"].isString()) {
-                    dict["/Contents"] = QPDFObjectHandle::newString(frame_->contents_string);
-                    dict["/Contents"].setParsedOffset(frame_->contents_offset);
+                    dict[Key(atom::Type)].isNameAndEquals("/Sig") &&
+                    dict.contains("/ByteRange") && dict.contains("/Contents") &&
+                    dict[Key(atom::Contents)].isString()) {
+                    auto& contents = dict[Key(atom::Contents)];
+                    contents = QPDFObjectHandle::newString(frame_->contents_string);
+                    contents.setParsedOffset(frame_->contents_offset);
                 }
                 auto object = QPDFObject::create<QPDF_Dictionary>(std::move(dict));
                 set_description(object, frame_->offset - 2);
@@ -440,6 +489,12 @@ Parser::parse_remainder(bool content_stream)
                     "parser-max-nesting", "ignoring excessively deeply nested data structure");
             }
             b_contents = false;
+            if (tokenizer_.getType() == QPDFTokenizer::tt_array_open) {
+                if (auto object = lazy_array()) {
+                    add(std::move(object));
+                    continue;
+                }
+            }
             stack_.emplace_back(
                 input_,
                 (tokenizer_.getType() == QPDFTokenizer::tt_array_open) ? st_array
@@ -459,10 +514,10 @@ Parser::parse_remainder(bool content_stream)
             if (!content_stream) {
                 // Buffer token in case it is part of an indirect reference.
                 last_offset_buffer_[1] = input_.getLastOffset();
-                int_buffer_[1] = QUtil::string_to_ll(tokenizer_.getValue().c_str());
+                int_buffer_[1] = tokenizer_.getIntValue();
                 int_count_ = 1;
             } else {
-                add_scalar<QPDF_Integer>(QUtil::string_to_ll(tokenizer_.getValue().c_str()));
+                add_scalar<QPDF_Integer>(tokenizer_.getIntValue());
             }
             continue;
 
@@ -472,9 +527,9 @@ Parser::parse_remainder(bool content_stream)
 
         case QPDFTokenizer::tt_name:
             if (frame_->state == st_dictionary_key) {
-                frame_->key = tokenizer_.getValue();
+                frame_->key = Key(tokenizer_.getValue());
                 frame_->state = st_dictionary_value;
-                b_contents = decrypter_ && frame_->key == "/Contents";
+                b_contents = decrypter_ && frame_->key.atom() == atom::Contents;
                 continue;
             } else {
                 add_scalar<QPDF_Name>(tokenizer_.getValue());
@@ -531,6 +586,81 @@ Parser::parse_remainder(bool content_stream)
     }
 }
 
+std::shared_ptr<QPDFObject>
+Parser::lazy_array()
+{
+    // Only arrays that are at least `lookahead` bytes long and whose first `lookahead` bytes
+    // contain no array delimiters are candidates. For short arrays, recording the elements costs
+    // more than parsing them.
+    static constexpr size_t lookahead = 96;
+    if (!lazy_) {
+        return {};
+    }
+    auto start = input_.tell();
+    input_.fastTell();
+    auto view = input_.fastView();
+    if (view.size() < lookahead) {
+        input_.loadBuffer();
+        input_.seek(start, SEEK_SET);
+        input_.fastTell();
+        view = input_.fastView();
+    }
+    if (view.size() < lookahead || view.substr(0, lookahead).find_first_of("[]") != view.npos) {
+        input_.seek(start, SEEK_SET);
+        return {};
+    }
+    input_.seek(start, SEEK_SET);
+
+    // Record the elements. Give up and let the caller parse the array normally on anything other
+    // than a well-formed scalar or indirect reference so that any warnings are issued as usual.
+    std::vector<LazyElements::Element> elements;
+    auto limit = Limits::parser_max_container_size(false);
+    while (elements.size() < limit && tokenizer_.nextToken(input_, object_description_)) {
+        auto offset = input_.getLastOffset();
+        auto type = tokenizer_.getType();
+        if (type == QPDFTokenizer::tt_array_close) {
+            auto object = QPDFObject::create<QPDF_Array>(std::make_shared<LazyElements const>(
+                LazyElements{lazy_, description_, std::move(elements)}));
+            set_description(object, start - 1);
+            return object;
+        }
+        if (type == QPDFTokenizer::tt_integer) {
+            elements.push_back(
+                {offset,
+                 tokenizer_.getIntValue(),
+                 0,
+                 LazyElements::k_integer});
+            continue;
+        }
+        if (type == QPDFTokenizer::tt_word) {
+            auto n = elements.size();
+            if (tokenizer_.getValue() != "R" || n < 2) {
+                break;
+            }
+            auto& id = elements[n - 2];
+            auto const& gen = elements[n - 1];
+            if (id.kind != LazyElements::k_integer || gen.kind != LazyElements::k_integer ||
+                id.value < 1 || id.value > std::numeric_limits<int>::max() || gen.value < 0 ||
+                gen.value >= 65535) {
+                break;
+            }
+            id.gen = static_cast<int>(gen.value);
+            id.kind = LazyElements::k_reference;
+            elements.pop_back();
+            continue;
+        }
+        if (type == QPDFTokenizer::tt_real || type == QPDFTokenizer::tt_name ||
+            type == QPDFTokenizer::tt_string || type == QPDFTokenizer::tt_bool ||
+            type == QPDFTokenizer::tt_null) {
+            elements.push_back({offset, 0, 0, LazyElements::k_other});
+            continue;
+        }
+        break;
+    }
+    input_.seek(start, SEEK_SET);
+    return {};
+}
+
 void
 Parser::add(std::shared_ptr<QPDFObject>&& obj)
 {
@@ -632,7 +762,7 @@ Parser::fix_missing_keys()
                 warn(
                     frame_->offset,
                     "expected dictionary key but found non-name object; inserting key " + key);
-                frame_->dict[key] = item;
+                frame_->dict[Key(key)] = item;
                 break;
             }
         }
@@ -700,7 +830,7 @@ Parser::warn_duplicate_key()
 {
     warn(
         frame_->offset,
-        "dictionary has duplicated key " + frame_->key +
+        "dictionary has duplicated key " + frame_->key.name() +
             "; last occurrence overrides earlier ones");
     check_too_many_bad_tokens();
 }
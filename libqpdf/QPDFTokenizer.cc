@@ -11,6 +11,7 @@
 #include <qpdf/QUtil.hh>
 #include <qpdf/Util.hh>
 
+#include <array>
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
@@ -20,7 +21,7 @@ using namespace qpdf;
 using Token = QPDFTokenizer::Token;
 using tt = QPDFTokenizer::token_type_e;
 
-static inline bool
+static inline constexpr bool
 is_delimiter(char ch)
 {
     return (
@@ -31,6 +32,68 @@ is_delimiter(char ch)
 
 namespace
 {
+    // Character classes used by Tokenizer::scanRun.
+    enum char_class : unsigned char {
+        cc_space = 1 << 0,
+        cc_delimiter = 1 << 1,
+        cc_digit = 1 << 2,
+        cc_hex = 1 << 3,
+        cc_eol = 1 << 4,
+        cc_string = 1 << 5, // characters that need special handling inside literal strings
+        cc_name = 1 << 6,   // characters that need special handling inside names
+    };
+
+    constexpr auto char_classes = [] {
+        std::array<unsigned char, 256> table{};
+        for (int i = 0; i < 256; ++i) {
+            auto ch = static_cast<char>(i);
+            unsigned char cls = 0;
+            if (ch == '\0' || util::is_space(ch)) {
+                cls |= cc_space;
+            }
+            if (is_delimiter(ch)) {
+                cls |= cc_delimiter | cc_name;
+            }
+            if (ch >= '0' && ch <= '9') {
+                cls |= cc_digit;
+            }
+            if (util::hex_decode_char(ch) < '\20') {
+                cls |= cc_hex;
+            }
+            if (ch == '\r' || ch == '\n') {
+                cls |= cc_eol;
+            }
+            if (ch == '\\' || ch == '(' || ch == ')' || ch == '\r') {
+                cls |= cc_string;
+            }
+            if (ch == '#') {
+                cls |= cc_name;
+            }
+            table[static_cast<size_t>(i)] = cls;
+        }
+        return table;
+    }();
+
+    inline unsigned char
+    char_class(char ch)
+    {
+        return char_classes[static_cast<unsigned char>(ch)];
+    }
+
+    // Return the length of the longest prefix of data consisting of characters that have at least
+    // one of the classes in mask, or none of them if negate is true.
+    inline size_t
+    span(std::string_view data, unsigned char mask, bool negate)
+    {
+        size_t n = 0;
+        for (auto const size = data.size(); n < size; ++n) {
+            if (((char_class(data[n]) & mask) == 0) != negate) {
+                break;
+            }
+        }
+        return n;
+    }
+
     class QPDFWordTokenFinder: public InputSource::Finder
     {
       public:
@@ -94,6 +157,17 @@ Tokenizer::reset()
     inline_image_bytes = 0;
     string_depth = 0;
     bad = false;
+    int_magnitude = 0;
+    int_negative = false;
+    int_overflow = false;
+}
+
+long long
+Tokenizer::intOverflow() const
+{
+    // Let string_to_ll report the overflow so that the error is the same as when converting the
+    // token's text.
+    return QUtil::string_to_ll(raw_val.c_str());
 }
 
 QPDFTokenizer::Token::Token(token_type_e type, std::string const& value) :
@@ -360,11 +434,13 @@ Tokenizer::inTop(char ch)
     case '8':
     case '9':
         state = st_number;
+        addDigit(ch);
         return;
 
     case '+':
     case '-':
         state = st_sign;
+        int_negative = ch == '-';
         return;
 
     case '.':
@@ -515,6 +591,7 @@ Tokenizer::inSign(char ch)
 {
     if (util::is_digit(ch)) {
         state = st_number;
+        addDigit(ch);
     } else if (ch == '.') {
         state = st_decimal;
     } else {
@@ -538,6 +615,7 @@ void
 Tokenizer::inNumber(char ch)
 {
     if (util::is_digit(ch)) {
+        addDigit(ch);
     } else if (ch == '.') {
         state = st_real;
     } else if (isDelimiter(ch)) {
@@ -978,6 +1056,94 @@ Tokenizer::readToken(InputSource& input, std::string const& context, bool allow_
     return token;
 }
 
+void
+Tokenizer::scanRun(InputSource& input, qpdf_offset_t& offset, size_t max_len)
+{
+    // Consume the run of characters at the current position of input that would leave the lexer in
+    // its current state, without passing them through handleCharacter one at a time. Only
+    // characters already in the input's buffer are considered. The run stops at the first
+    // character that would cause a state change, which, like the end of the buffer, is left to the
+    // state machine.
+    auto data = input.fastView();
+    if (data.empty()) {
+        return;
+    }
+    if (in_token && max_len) {
+        // Stop one character short of the limit so that the state machine detects long tokens.
+        if (raw_val.size() + 1 >= max_len) {
+            return;
+        }
+        data = data.substr(0, max_len - 1 - raw_val.size());
+    }
+
+    size_t n = 0;
+    switch (state) {
+    case st_before_token:
+    case st_in_space:
+        n = span(data, cc_space, false);
+        break;
+
+    case st_in_comment:
+        n = span(data, cc_eol, true);
+        break;
+
+    case st_literal:
+        n = span(data, cc_delimiter, true);
+        break;
+
+    case st_number:
+        n = span(data, cc_digit, false);
+        for (size_t i = 0; i < n; ++i) {
+            addDigit(data[i]);
+        }
+        break;
+
+    case st_real:
+        n = span(data, cc_digit, false);
+        break;
+
+    case st_name:
+        n = span(data, cc_name, true);
+        val.append(data.data(), n);
+        break;
+
+    case st_in_string:
+        n = span(data, cc_string, true);
+        val.append(data.data(), n);
+        break;
+
+    case st_in_hexstring:
+    case st_in_hexstring_2nd:
+        for (auto const size = data.size(); n < size; ++n) {
+            auto ch = data[n];
+            auto cls = char_class(ch);
+            if (cls & cc_hex) {
+                if (state == st_in_hexstring) {
+                    char_code = int(util::hex_decode_char(ch)) << 4;
+                    state = st_in_hexstring_2nd;
+                } else {
+                    val += char(char_code) | util::hex_decode_char(ch);
+                    state = st_in_hexstring;
+                }
+            } else if (!(cls & cc_space)) {
+                break;
+            }
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    if (before_token) {
+        offset += QIntC::to_offset(n);
+    }
+    if (in_token) {
+        raw_val.append(data.data(), n);
+    }
+    input.fastSkip(n);
+}
+
 bool
 Tokenizer::nextToken(InputSource& input, std::string const& context, size_t max_len)
 {
@@ -1012,6 +1178,8 @@ Tokenizer::nextToken(InputSource& input, std::string const& context, size_t max_
                 type = tt::tt_bad;
                 state = st_token_ready;
                 error_message = "exceeded allowable length while reading token";
+            } else {
+                scanRun(input, offset, max_len);
             }
         }
     }
@@ -7,6 +7,7 @@
 #include <qpdf/Pl_Flate.hh>
 #include <qpdf/Pl_MD5.hh>
 #include <qpdf/Pl_PNGFilter.hh>
+#include <qpdf/Pl_ParallelDeflate.hh>
 #include <qpdf/Pl_RC4.hh>
 #include <qpdf/Pl_StdioFile.hh>
 #include <qpdf/QIntC.hh>
@@ -17,10 +18,12 @@
 #include <qpdf/QUtil.hh>
 #include <qpdf/RC4.hh>
 #include <qpdf/Util.hh>
+#include <qpdf/WorkerPool.hh>
 
 #include <algorithm>
 #include <concepts>
 #include <cstdlib>
+#include <future>
 #include <stdexcept>
 #include <tuple>
 
@@ -181,6 +184,16 @@ namespace
             top = c.get();
             stack.emplace_back(std::move(c));
         }
+        // Pass everything written to 'next' immediately. 'next' is not owned by the stack.
+        void
+        activate(Popper& pp, Pipeline& next)
+        {
+            auto c = std::make_unique<pl::Count>(++last_id, &next);
+            pp.stack_id = last_id;
+            top = c.get();
+            stack.emplace_back(std::move(c));
+        }
+
         void
         activate_md5(Popper& pp)
         {
@@ -243,6 +256,48 @@ namespace
         unsigned long md5_id{0};
         std::string count_buffer;
     };
+
+    // Pipeline used to write stream data straight to the output. It passes data on to 'next' and
+    // keeps track of the last character written. 'finish' is only passed on if 'finish_next' is
+    // true, so that the output pipeline is not finished at the end of each stream.
+    class StreamDataSink final: public Pipeline
+    {
+      public:
+        StreamDataSink(Pipeline* next, bool finish_next) :
+            Pipeline("stream data", next),
+            finish_next(finish_next)
+        {
+        }
+
+        ~StreamDataSink() final = default;
+
+        void
+        write(unsigned char const* buf, size_t len) final
+        {
+            if (len) {
+                last = static_cast<char>(buf[len - 1]);
+                next()->write(buf, len);
+            }
+        }
+
+        void
+        finish() final
+        {
+            if (finish_next) {
+                next()->finish();
+            }
+        }
+
+        char
+        last_char() const
+        {
+            return last;
+        }
+
+      private:
+        bool finish_next;
+        char last{'\0'};
+    };
 } // namespace
 
 Pl_stack::Popper::~Popper()
@@ -332,11 +387,40 @@ namespace qpdf::impl
         void assignCompressedObjectNumbers(QPDFObjGen og);
         Dictionary trimmed_trailer();
 
-        // Returns tuple<filter, compress_stream, is_root_metadata>
-        std::tuple<const bool, const bool, const bool>
-        will_filter_stream(QPDFObjectHandle stream, std::string* stream_data);
-
-        // Test whether stream would be filtered if it were written.
+        // Returns tuple<filter, compress_stream, is_root_metadata>. If raw_data is not null and the
+        // stream is written unfiltered with its raw data available in memory, raw_data is set to a
+        // view of the raw data and stream_data is left empty. Otherwise, if write_directly is not
+        // null and the stream is written unfiltered, write_directly is set to true and stream_data
+        // is left empty. The caller must then write the stream data using write_stream_data. If
+        // defer_compression is not null and the stream data would be compressed after decoding,
+        // stream_data is left uncompressed and defer_compression is set to true.
+        std::tuple<const bool, const bool, const bool> will_filter_stream(
+            QPDFObjectHandle stream,
+            std::string* stream_data,
+            std::optional<std::string_view>* raw_data = nullptr,
+            bool* write_directly = nullptr,
+            bool* defer_compression = nullptr);
+        // Returns tuple<filter, encode_flags, decode_level, is_root_metadata>.
+        std::tuple<bool, int, qpdf_stream_decode_level_e, bool>
+        stream_filter(QPDFObjectHandle stream);
+        // Keep filtered stream data in filtered_streams, if it fits, for use by the next call to
+        // will_filter_stream for the same stream. If deferred is true, the data is compressed on a
+        // worker thread.
+        void keep_filtered_stream(
+            QPDFObjectHandle stream,
+            std::tuple<const bool, const bool, const bool> result,
+            std::string&& data,
+            bool deferred);
+        // Compress stream data that will_filter_stream left uncompressed.
+        std::string deflate(std::string const& data);
+        bool compress_in_blocks(size_t size) const;
+        // Get the streams from object_queue[next] onward ready for writing, compressing them on
+        // worker threads.
+        void filter_ahead(size_t next);
+
+        // Test whether stream would be filtered if it were written. The filtered data is kept in
+        // filtered_streams, if it fits, for use by the next call to will_filter_stream for the same
+        // stream.
         bool will_filter_stream(QPDFObjectHandle stream);
         unsigned int bytesNeeded(long long n);
         void writeBinary(unsigned long long val, unsigned int bytes);
@@ -346,6 +430,7 @@ namespace qpdf::impl
         Writer& write_name(std::string const& str);
         Writer& write_string(std::string const& str, bool force_binary = false);
         Writer& write_encrypted(std::string_view str);
+        char write_stream_data(QPDFObjectHandle stream);
 
         template <typename... Args>
         Writer& write_qdf(Args&&... args);
@@ -453,9 +538,25 @@ namespace qpdf::impl
         size_t cur_stream_length{0};
         bool added_newline{false};
         size_t max_ostream_index{0};
-        std::set<QPDFObjGen> normalized_streams;
-        std::map<QPDFObjGen, int> page_object_to_seq;
-        std::map<QPDFObjGen, int> contents_to_page_seq;
+        // Filtered stream data computed ahead of writing the stream, either while optimizing a
+        // file for linearization or to compress streams on worker threads. size is the size of the
+        // data before any deferred compression.
+        struct FilteredStream
+        {
+            std::tuple<bool, bool, bool> result;
+            std::string data;
+            std::future<std::string> compressed;
+            size_t size{0};
+        };
+        std::map<QPDFObjGen, FilteredStream> filtered_streams;
+        // Warnings issued while filtering streams ahead of writing them, held back until the stream
+        // is written.
+        std::map<QPDFObjGen, std::vector<QPDFExc>> held_warnings;
+        size_t filtered_streams_size{0};
+        static constexpr size_t filtered_streams_limit = 64 << 20;
+        std::unique_ptr<WorkerPool> workers;
+        size_t deferred_streams{0};
+        size_t filter_ahead_pos{0};
         std::map<int, std::vector<QPDFObjGen>> object_stream_to_objects;
         Pl_stack pipeline_stack;
         std::string deterministic_id_data;
@@ -527,7 +628,9 @@ QPDFWriter::setOutputFile(char const* description, FILE* file, bool close_file)
     m->filename = description;
     m->file = file;
     m->close_file = close_file;
-    m->file_pl = std::make_unique<Pl_StdioFile>("qpdf output", file);
+    // The writer produces many small writes, so buffer them rather than passing each one to stdio.
+    m->file_pl = std::make_unique<pl::Buffered>(
+        "qpdf output", std::make_unique<Pl_StdioFile>("qpdf output", file));
     m->pipeline_stack.initialize(m->file_pl.get());
 }
 
@@ -635,6 +738,18 @@ QPDFWriter::setRecompressFlate(bool val)
     m->cfg.recompress_flate(val);
 }
 
+void
+QPDFWriter::setCompressionThreads(size_t threads)
+{
+    m->cfg.compression_threads(threads);
+}
+
+void
+QPDFWriter::setDeflateBlockSize(size_t bytes)
+{
+    m->cfg.deflate_block_size(bytes);
+}
+
 void
 QPDFWriter::setContentNormalization(bool val)
 {
@@ -676,6 +791,28 @@ Config::qdf(bool val)
     return *this;
 }
 
+void
+QPDFWriter::setDirectStreamLengths(bool val)
+{
+    m->cfg.direct_stream_lengths(val);
+}
+
+Config&
+Config::direct_stream_lengths(bool val)
+{
+    if (!val && linearize_) {
+        usage("indirect stream lengths cannot be used when linearize is set");
+        return *this;
+    }
+    if (val && qdf_) {
+        // fix-qdf relies on the indirect stream lengths written in qdf mode.
+        usage("direct stream lengths cannot be used when qdf is set");
+        return *this;
+    }
+    direct_stream_lengths_ = val;
+    return *this;
+}
+
 void
 QPDFWriter::setPreserveUnreferencedObjects(bool val)
 {
@@ -807,6 +944,10 @@ Config::linearize(bool val)
         usage("linearize cannot be set when qdf or pclm are set");
         return *this;
     }
+    if (val && !direct_stream_lengths_) {
+        usage("linearize cannot be set when indirect stream lengths are used");
+        return *this;
+    }
     linearize_ = val;
     return *this;
 }
@@ -1338,6 +1479,33 @@ impl::Writer::write_encrypted(std::string_view str)
     return *this;
 }
 
+char
+impl::Writer::write_stream_data(QPDFObjectHandle stream)
+{
+    // Write the unfiltered data of stream, encrypting it if necessary, and set cur_stream_length
+    // to the number of bytes written. Return the last unencrypted character written, or '\0' if
+    // the stream is empty.
+    auto start = pipeline->getCount();
+    StreamDataSink sink(pipeline, false);
+    std::unique_ptr<Pipeline> encrypt;
+    if (encryption && !cur_data_key.empty()) {
+        if (cfg.encrypt_use_aes()) {
+            encrypt = std::make_unique<Pl_AES_PDF>("stream data", &sink, true, cur_data_key);
+        } else {
+            encrypt = std::make_unique<Pl_RC4>("stream data", &sink, cur_data_key);
+        }
+    }
+    StreamDataSink source(encrypt ? encrypt.get() : &sink, true);
+    try {
+        stream.pipeStreamData(&source, 0, qpdf_dl_none, false, true);
+    } catch (std::runtime_error& e) {
+        throw std::runtime_error(
+            "error while getting stream data for " + stream.unparse() + ": " + e.what());
+    }
+    cur_stream_length = QIntC::to_size(pipeline->getCount() - start);
+    return source.last_char();
+}
+
 void
 impl::Writer::computeDeterministicIDData()
 {
@@ -1540,12 +1708,113 @@ bool
 impl::Writer::will_filter_stream(QPDFObjectHandle stream)
 {
     std::string s;
-    [[maybe_unused]] auto [filter, ignore1, ignore2] = will_filter_stream(stream, &s);
-    return filter;
+    bool deferred = false;
+    auto result = will_filter_stream(stream, &s, nullptr, nullptr, workers ? &deferred : nullptr);
+    keep_filtered_stream(stream, result, std::move(s), deferred);
+    return std::get<0>(result);
 }
 
-std::tuple<const bool, const bool, const bool>
-impl::Writer::will_filter_stream(QPDFObjectHandle stream, std::string* stream_data)
+void
+impl::Writer::keep_filtered_stream(
+    QPDFObjectHandle stream,
+    std::tuple<const bool, const bool, const bool> result,
+    std::string&& data,
+    bool deferred)
+{
+    // Unfiltered data is cheap to get again and is usually written without an intermediate copy.
+    if (!std::get<0>(result) || data.size() > filtered_streams_limit - filtered_streams_size) {
+        return;
+    }
+    FilteredStream fs{result, {}, {}, data.size()};
+    filtered_streams_size += data.size();
+    if (deferred && compress_in_blocks(data.size())) {
+        // Large streams are split into blocks that are compressed on worker threads.
+        fs.data = deflate(data);
+    } else if (deferred) {
+        ++deferred_streams;
+        fs.compressed = workers->submit([data = std::move(data)] {
+            return pl::pipe<Pl_Flate>(data, Pl_Flate::a_deflate);
+        });
+    } else {
+        fs.data = std::move(data);
+    }
+    filtered_streams.insert_or_assign(stream.getObjGen(), std::move(fs));
+}
+
+bool
+impl::Writer::compress_in_blocks(size_t size) const
+{
+    auto block_size = cfg.deflate_block_size();
+    return workers && block_size && size > block_size && !Pl_Flate::zopfli_enabled();
+}
+
+std::string
+impl::Writer::deflate(std::string const& data)
+{
+    if (!compress_in_blocks(data.size())) {
+        return pl::pipe<Pl_Flate>(data, Pl_Flate::a_deflate);
+    }
+    std::string result;
+    pl::String s(result);
+    Pl_ParallelDeflate compressor("compress stream", &s, *workers, cfg.deflate_block_size());
+    compressor.write(reinterpret_cast<unsigned char const*>(data.data()), data.size());
+    compressor.finish();
+    return result;
+}
+
+void
+impl::Writer::filter_ahead(size_t next)
+{
+    if (!workers) {
+        return;
+    }
+    // Keep the worker threads busy by decoding the streams that follow the object about to be
+    // written and handing them over for compression.
+    filter_ahead_pos = std::max(filter_ahead_pos, next);
+    while (filter_ahead_pos < object_queue.size() && deferred_streams < 2 * workers->size() &&
+           filtered_streams_size < filtered_streams_limit) {
+        auto& object = object_queue[filter_ahead_pos++];
+        if (!object.isStream() || filtered_streams.contains(object.getObjGen())) {
+            continue;
+        }
+        auto [filter, encode_flags, decode_level, is_root_metadata] = stream_filter(object);
+        // Only streams that are going to be compressed are worth reading ahead.
+        if (!(filter && (encode_flags & qpdf_ef_compress))) {
+            continue;
+        }
+        // Hold back warnings until the stream is written so that they appear in the same order as
+        // without worker threads.
+        std::string data;
+        bool deferred = false;
+        std::vector<QPDFExc> warnings;
+        std::optional<std::tuple<const bool, const bool, const bool>> result;
+        try {
+            HoldWarnings hold(*this, warnings);
+            if (object.pipeStreamData(nullptr, encode_flags, decode_level, true)) {
+                result.emplace(will_filter_stream(object, &data, nullptr, nullptr, &deferred));
+            }
+        } catch (...) {
+            for (auto const& w: warnings) {
+                warn(w);
+            }
+            throw;
+        }
+        if (!result) {
+            // The stream is checked again when it is written.
+            continue;
+        }
+        keep_filtered_stream(object, *result, std::move(data), deferred);
+        // If filtering failed, the stream is written unfiltered without filtering it again.
+        // Otherwise, data that was not kept is filtered again, which issues the warnings again.
+        if (!warnings.empty() &&
+            (!std::get<0>(*result) || filtered_streams.contains(object.getObjGen()))) {
+            held_warnings.insert_or_assign(object.getObjGen(), std::move(warnings));
+        }
+    }
+}
+
+std::tuple<bool, int, qpdf_stream_decode_level_e, bool>
+impl::Writer::stream_filter(QPDFObjectHandle stream)
 {
     const bool is_root_metadata = stream.isRootMetadata();
     bool filter = false;
@@ -1569,7 +1838,7 @@ impl::Writer::will_filter_stream(QPDFObjectHandle stream, std::string* stream_da
         if (is_root_metadata && (!encryption || !encryption->getEncryptMetadata())) {
             filter = true;
             decode_level = qpdf_dl_all;
-        } else if (cfg.normalize_content() && normalized_streams.contains(stream)) {
+        } else if (cfg.normalize_content() && obj[stream].contents_page) {
             encode_flags = qpdf_ef_normalize;
             filter = true;
         } else if (filter && cfg.compress_streams()) {
@@ -1582,6 +1851,80 @@ impl::Writer::will_filter_stream(QPDFObjectHandle stream, std::string* stream_da
         filter = true;
         encode_flags = 0;
     }
+    return {filter, encode_flags, decode_level, is_root_metadata};
+}
+
+std::tuple<const bool, const bool, const bool>
+impl::Writer::will_filter_stream(
+    QPDFObjectHandle stream,
+    std::string* stream_data,
+    std::optional<std::string_view>* raw_data,
+    bool* write_directly,
+    bool* defer_compression)
+{
+    std::vector<QPDFExc> warnings;
+    if (auto it = held_warnings.find(stream.getObjGen()); it != held_warnings.end()) {
+        warnings = std::move(it->second);
+        held_warnings.erase(it);
+    }
+    if (stream_data && !filtered_streams.empty()) {
+        if (auto it = filtered_streams.find(stream.getObjGen()); it != filtered_streams.end()) {
+            auto& fs = it->second;
+            auto result = fs.result;
+            bool found = true;
+            filtered_streams_size -= fs.size;
+            if (fs.compressed.valid()) {
+                --deferred_streams;
+                try {
+                    *stream_data = fs.compressed.get();
+                } catch (std::exception&) {
+                    // Compress the stream again, reporting any errors in the usual way.
+                    found = false;
+                }
+            } else {
+                *stream_data = std::move(fs.data);
+            }
+            filtered_streams.erase(it);
+            if (found) {
+                for (auto const& w: warnings) {
+                    warn(w);
+                }
+                return result;
+            }
+            // The stream is filtered again below, which issues the warnings again.
+            warnings.clear();
+        }
+    }
+
+    for (auto const& w: warnings) {
+        warn(w);
+    }
+
+    auto [filter, encode_flags, decode_level, is_root_metadata] = stream_filter(stream);
+    const bool compress = encode_flags & qpdf_ef_compress;
+
+    if (raw_data && !filter) {
+        // Pass unfiltered stream data through without an intermediate copy if possible.
+        auto raw = Stream(stream).raw_data_view();
+        if (raw && !raw->empty()) {
+            *raw_data = raw;
+            return {false, false, is_root_metadata};
+        }
+    }
+
+    if (write_directly && !filter) {
+        // Unfiltered stream data is never retried, so it can be written straight to the output.
+        *write_directly = true;
+        return {false, false, is_root_metadata};
+    }
+
+    if (defer_compression && filter && compress &&
+        (encode_flags != qpdf_ef_compress || decode_level != qpdf_dl_none)) {
+        // Leave compression to the caller. Without any other encoding or decoding, the stream
+        // would not count as filtered, so such streams are compressed here.
+        encode_flags &= ~qpdf_ef_compress;
+        *defer_compression = true;
+    }
 
     for (bool first_attempt: {true, false}) {
         auto pp_stream_data =
@@ -1594,7 +1937,7 @@ impl::Writer::will_filter_stream(QPDFObjectHandle stream, std::string* stream_da
                     filter ? decode_level : qpdf_dl_none,
                     false,
                     first_attempt)) {
-                return {true, encode_flags & qpdf_ef_compress, is_root_metadata};
+                return {true, compress, is_root_metadata};
             }
             if (!filter) {
                 break;
@@ -1613,6 +1956,9 @@ impl::Writer::will_filter_stream(QPDFObjectHandle stream, std::string* stream_da
         if (stream_data) {
             stream_data->clear();
         }
+        if (defer_compression) {
+            *defer_compression = false;
+        }
     }
     return {false, false, is_root_metadata};
 }
@@ -1809,8 +2155,23 @@ impl::Writer::unparseObject(
         }
 
         flags |= f_stream;
-        std::string stream_data;
-        auto [filter, compress_stream, is_root_metadata] = will_filter_stream(object, &stream_data);
+        std::string stream_buffer;
+        std::optional<std::string_view> raw_data;
+        // With indirect stream lengths, the length is written after the stream, so unfiltered
+        // stream data doesn't need to be buffered.
+        bool write_directly = false;
+        // Very large streams are compressed in blocks on worker threads.
+        bool deferred = false;
+        auto [filter, compress_stream, is_root_metadata] = will_filter_stream(
+            object,
+            &stream_buffer,
+            &raw_data,
+            cfg.direct_stream_lengths() ? nullptr : &write_directly,
+            workers && cfg.deflate_block_size() ? &deferred : nullptr);
+        if (deferred) {
+            stream_buffer = deflate(stream_buffer);
+        }
+        std::string_view stream_data = raw_data ? *raw_data : stream_buffer;
         if (filter) {
             flags |= f_filtered;
         }
@@ -1824,7 +2185,12 @@ impl::Writer::unparseObject(
         adjustAESStreamLength(cur_stream_length);
         unparseObject(stream_dict, 0, flags, cur_stream_length, compress_stream);
         char last_char = stream_data.empty() ? '\0' : stream_data.back();
-        write("\nstream\n").write_encrypted(stream_data);
+        write("\nstream\n");
+        if (write_directly) {
+            last_char = write_stream_data(object);
+        } else {
+            write_encrypted(stream_data);
+        }
         added_newline = cfg.newline_before_endstream() || (cfg.qdf() && last_char != '\n');
         write(added_newline ? "\nendstream" : "endstream");
     } else if (tc == ::ot_string) {
@@ -2009,11 +2375,12 @@ impl::Writer::writeObject(QPDFObjectHandle object, int object_stream_index)
     indicateProgress(false, false);
     auto new_id = obj[old_og].renumber;
     if (cfg.qdf()) {
-        if (page_object_to_seq.contains(old_og)) {
-            write("%% Page ").write(page_object_to_seq[old_og]).write("\n");
+        auto const& o = obj[old_og];
+        if (o.page) {
+            write("%% Page ").write(o.page).write("\n");
         }
-        if (contents_to_page_seq.contains(old_og)) {
-            write("%% Contents for page ").write(contents_to_page_seq[old_og]).write("\n");
+        if (o.contents_page) {
+            write("%% Contents for page ").write(o.contents_page).write("\n");
         }
     }
     if (object_stream_index == -1) {
@@ -2147,7 +2514,7 @@ impl::Writer::initializeSpecialStreams()
     // Mark all page content streams in case we are filtering or normalizing.
     int num = 0;
     for (auto& page: pages) {
-        page_object_to_seq[page.getObjGen()] = ++num;
+        obj[page].page = ++num;
         QPDFObjectHandle contents = page.getKey("/Contents");
         std::vector<QPDFObjGen> contents_objects;
         if (contents.isArray()) {
@@ -2160,8 +2527,7 @@ impl::Writer::initializeSpecialStreams()
         }
 
         for (auto const& c: contents_objects) {
-            contents_to_page_seq[c] = num;
-            normalized_streams.insert(c);
+            obj[c].contents_page = num;
         }
     }
 }
@@ -2437,11 +2803,16 @@ impl::Writer::write()
 
     prepareFileForWrite();
 
+    if (cfg.compression_threads() > 0) {
+        workers = std::make_unique<WorkerPool>(cfg.compression_threads());
+    }
+
     if (cfg.linearize()) {
         writeLinearized();
     } else {
         writeStandard();
     }
+    workers = nullptr;
 
     pipeline->finish();
     if (close_file) {
@@ -2873,8 +3244,15 @@ impl::Writer::writeLinearized()
     std::string hint_buffer;
 
     // Write file in two passes.  Part numbers refer to PDF spec 1.4.
+    //
+    // Objects are written identically in both passes. Only their offsets change, since the hint
+    // stream, whose size is only known after pass 1, is inserted in pass 2. Unless the pass 1
+    // output is requested, keep a copy of it so that in pass 2 the objects don't have to be
+    // written again. If the copy can't be kept, write the objects again instead.
 
     FILE* lin_pass1_file = nullptr;
+    std::unique_ptr<pl::Replay> replay;
+    qpdf_offset_t objects_start = 0;
     auto pp_pass1 = pipeline_stack.popper();
     auto pp_md5 = pipeline_stack.popper();
     for (int pass: {1, 2}) {
@@ -2885,7 +3263,8 @@ impl::Writer::writeLinearized()
                     pp_pass1,
                     std::make_unique<Pl_StdioFile>("linearization pass1", lin_pass1_file));
             } else {
-                pipeline_stack.activate(pp_pass1, true);
+                replay = std::make_unique<pl::Replay>("linearization pass 1 replay");
+                pipeline_stack.activate(pp_pass1, *replay);
             }
             if (cfg.deterministic_id()) {
                 pipeline_stack.activate_md5(pp_md5);
@@ -2989,24 +3368,51 @@ impl::Writer::writeLinearized()
 
         // Parts 4 through 9
 
-        for (auto const& cur_object: object_queue) {
-            if (cur_object.getObjectID() == part6_end_marker) {
-                first_half_max_obj_offset = pipeline->getCount();
-            }
-            writeObject(cur_object);
-            if (cur_object.getObjectID() == part4_end_marker) {
-                if (encryption) {
-                    writeEncryptionDictionary();
+        if (pass == 1) {
+            objects_start = pipeline->getCount();
+        }
+        if (pass == 2 && replay && replay->ok()) {
+            // Copy parts 4 through 9 from pass 1, inserting the hint stream, and move the offsets
+            // of all objects after the hint stream to where they are now.
+            replay->replay(*pipeline, objects_start, hint_offset);
+            // Part 5: hint stream
+            write(hint_buffer);
+            replay->replay(*pipeline, hint_offset, second_xref_offset);
+            replay = nullptr;
+            for (int i = 1; i < first_trailer_size; ++i) {
+                auto& e = new_obj[i].xref;
+                if (i != hint_id && e.getType() == 1 && e.getOffset() >= hint_offset) {
+                    e = QPDFXRefEntry(e.getOffset() + hint_length);
                 }
-                if (pass == 1) {
-                    new_obj[hint_id].xref = QPDFXRefEntry(pipeline->getCount());
-                } else {
-                    // Part 5: hint stream
-                    write(hint_buffer);
+            }
+            for (auto const& cur_object: object_queue) {
+                auto og = cur_object.getObjGen();
+                if (!(og.getGen() == 0 && object_stream_to_objects.contains(og.getObj()))) {
+                    indicateProgress(false, false);
                 }
             }
-            if (cur_object.getObjectID() == part6_end_marker) {
-                part6_end_offset = pipeline->getCount();
+        } else {
+            for (size_t i = 0; i < object_queue.size(); ++i) {
+                auto cur_object = object_queue[i];
+                filter_ahead(i + 1);
+                if (cur_object.getObjectID() == part6_end_marker) {
+                    first_half_max_obj_offset = pipeline->getCount();
+                }
+                writeObject(cur_object);
+                if (cur_object.getObjectID() == part4_end_marker) {
+                    if (encryption) {
+                        writeEncryptionDictionary();
+                    }
+                    if (pass == 1) {
+                        new_obj[hint_id].xref = QPDFXRefEntry(pipeline->getCount());
+                    } else {
+                        // Part 5: hint stream
+                        write(hint_buffer);
+                    }
+                }
+                if (cur_object.getObjectID() == part6_end_marker) {
+                    part6_end_offset = pipeline->getCount();
+                }
             }
         }
 
@@ -3066,6 +3472,10 @@ impl::Writer::writeLinearized()
             // Close first pass pipeline
             file_size = pipeline->getCount();
             pp_pass1.pop();
+            filtered_streams.clear();
+            filtered_streams_size = 0;
+            deferred_streams = 0;
+            filter_ahead_pos = 0;
 
             // Save hint offset since it will be set to zero by calling openObject.
             qpdf_offset_t hint_offset1 = new_obj[hint_id].xref.getOffset();
@@ -3202,6 +3612,7 @@ impl::Writer::writeStandard()
     while (object_queue_front < object_queue.size()) {
         QPDFObjectHandle cur_object = object_queue.at(object_queue_front);
         ++object_queue_front;
+        filter_ahead(object_queue_front);
         writeObject(cur_object);
     }
 
@@ -1,5 +1,7 @@
 #include <qpdf/QPDFObjectHandle_private.hh>
 
+#include <qpdf/QPDFParser.hh>
+
 #include <qpdf/QTC.hh>
 
 #include <array>
@@ -50,10 +52,42 @@ QPDF_Array::QPDF_Array(std::vector<QPDFObjectHandle>&& v, bool sparse)
     }
 }
 
+QPDF_Array::QPDF_Array(std::shared_ptr<impl::LazyElements const> lazy) :
+    sp(std::make_unique<Sparse>())
+{
+    sp->size = lazy->elements.size();
+    sp->lazy = std::move(lazy);
+}
+
+QPDFObjectHandle const&
+QPDF_Array::lazy_element(size_t n)
+{
+    if (auto it = sp->elements.find(n); it != sp->elements.end()) {
+        return it->second;
+    }
+    return sp->elements.emplace(n, impl::Parser::parse_lazy(*sp->lazy, n)).first->second;
+}
+
+void
+QPDF_Array::materialize_lazy()
+{
+    std::vector<QPDFObjectHandle> items;
+    items.reserve(sp->size);
+    for (size_t i = 0; i < sp->size; ++i) {
+        auto it = sp->elements.find(i);
+        items.emplace_back(
+            it != sp->elements.end() ? std::move(it->second)
+                                     : impl::Parser::parse_lazy(*sp->lazy, i));
+    }
+    elements = std::move(items);
+    sp.reset();
+}
+
 QPDF_Array*
 Array::array() const
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         return a;
     }
 
@@ -81,6 +115,7 @@ Array::iterator
 Array::begin()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.begin();
         }
@@ -96,6 +131,7 @@ Array::iterator
 Array::end()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.end();
         }
@@ -111,6 +147,7 @@ Array::const_iterator
 Array::cbegin()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.cbegin();
         }
@@ -126,6 +163,7 @@ Array::const_iterator
 Array::cend()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.cend();
         }
@@ -141,6 +179,7 @@ Array::const_reverse_iterator
 Array::crbegin()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.crbegin();
         }
@@ -156,6 +195,7 @@ Array::const_reverse_iterator
 Array::crend()
 {
     if (auto a = as<QPDF_Array>()) {
+        a->materialize();
         if (!a->sp) {
             return a->elements.crend();
         }
@@ -191,6 +231,9 @@ Array::operator[](size_t n) const
         return null_obj;
     }
     if (a->sp) {
+        if (a->sp->lazy) {
+            return n >= a->sp->size ? null_obj : a->lazy_element(n);
+        }
         auto const& iter = a->sp->elements.find(n);
         return iter == a->sp->elements.end() ? null_obj : iter->second;
     }
@@ -213,10 +256,13 @@ Array::get(size_t n) const
     if (n >= size()) {
         return {};
     }
-    auto a = array();
+    auto a = as<QPDF_Array>();
     if (!a->sp) {
         return a->elements[n];
     }
+    if (a->sp->lazy) {
+        return a->lazy_element(n);
+    }
     auto const& iter = a->sp->elements.find(n);
     return iter == a->sp->elements.end() ? null() : iter->second;
 }
@@ -48,7 +48,11 @@ BaseHandle::at(std::string const& key) const
     if (!d) {
         throw std::runtime_error("Expected a dictionary but found a non-dictionary object");
     }
-    return d->items[key];
+    auto it = d->items.lower_bound(key);
+    if (it == d->items.end() || it->first != key) {
+        it = d->items.emplace_hint(it, Key(key), QPDFObjectHandle());
+    }
+    return it->second;
 }
 
 /// @brief Checks if the specified key exists in the object.
@@ -106,10 +110,14 @@ BaseDictionary::getKeys()
     return result;
 }
 
-std::map<std::string, QPDFObjectHandle> const&
+std::map<std::string, QPDFObjectHandle>
 BaseDictionary::getAsMap() const
 {
-    return dict()->items;
+    std::map<std::string, QPDFObjectHandle> result;
+    for (auto const& [key, value]: dict()->items) {
+        result.emplace_hint(result.end(), key, value);
+    }
+    return result;
 }
 
 size_t
@@ -117,7 +125,10 @@ BaseHandle::erase(const std::string& key)
 {
     // no-op if key does not exist
     if (auto d = as<QPDF_Dictionary>()) {
-        return d->items.erase(key);
+        if (auto it = d->items.find(key); it != d->items.end()) {
+            d->items.erase(it);
+            return 1;
+        }
     }
     return 0;
 }
@@ -143,10 +154,17 @@ BaseHandle::replace(std::string const& key, QPDFObjectHandle value)
             // The PDF spec doesn't distinguish between keys with null values and missing keys.
             // Allow indirect nulls which are equivalent to a dangling reference, which is permitted
             // by the spec.
-            d->items.erase(key);
+            if (auto it = d->items.find(key); it != d->items.end()) {
+                d->items.erase(it);
+            }
         } else {
             // add or replace value
-            d->items[key] = value;
+            auto it = d->items.lower_bound(key);
+            if (it == d->items.end() || it->first != key) {
+                d->items.emplace_hint(it, Key(key), value);
+            } else {
+                it->second = value;
+            }
         }
         return true;
     }
@@ -0,0 +1,103 @@
+#include <qpdf/QPDFObject_private.hh>
+
+#include <qpdf/Util.hh>
+
+#include <cstdlib>
+
+using namespace qpdf;
+
+QPDF_Real::QPDF_Real(std::string_view val)
+{
+    auto p = val.begin();
+    auto end = val.end();
+    if (p != end && (*p == '-' || *p == '+')) {
+        sign = *p++;
+    }
+    auto int_start = p;
+    while (p != end && util::is_digit(*p)) {
+        ++p;
+    }
+    size_t n_int = static_cast<size_t>(p - int_start);
+    size_t n_frac = 0;
+    if (p != end && *p == '.') {
+        point = true;
+        auto frac_start = ++p;
+        while (p != end && util::is_digit(*p)) {
+            ++p;
+        }
+        n_frac = static_cast<size_t>(p - frac_start);
+    }
+    if (p != end || n_int + n_frac == 0 || n_int + n_frac > max_digits) {
+        digits = 0;
+        sign = 0;
+        point = false;
+        other = std::make_unique<std::string>(val);
+        return;
+    }
+    int_digits = static_cast<uint8_t>(n_int);
+    frac_digits = static_cast<uint8_t>(n_frac);
+    for (auto ch: val) {
+        if (util::is_digit(ch)) {
+            digits = 10 * digits + (ch - '0');
+        }
+    }
+}
+
+QPDF_Real::QPDF_Real(QPDF_Real const& rhs) :
+    digits(rhs.digits),
+    int_digits(rhs.int_digits),
+    frac_digits(rhs.frac_digits),
+    sign(rhs.sign),
+    point(rhs.point),
+    other(rhs.other ? std::make_unique<std::string>(*rhs.other) : nullptr)
+{
+}
+
+QPDF_Real&
+QPDF_Real::operator=(QPDF_Real const& rhs)
+{
+    if (this != &rhs) {
+        *this = QPDF_Real(rhs);
+    }
+    return *this;
+}
+
+std::string
+QPDF_Real::text() const
+{
+    if (other) {
+        return *other;
+    }
+    char buf[max_digits];
+    auto v = digits;
+    for (size_t i = int_digits + frac_digits; i > 0; --i) {
+        buf[i - 1] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    }
+    std::string result;
+    result.reserve(int_digits + frac_digits + 2U);
+    if (sign) {
+        result += sign;
+    }
+    result.append(buf, int_digits);
+    if (point) {
+        result += '.';
+        result.append(buf + int_digits, frac_digits);
+    }
+    return result;
+}
+
+double
+QPDF_Real::value() const
+{
+    if (other) {
+        return atof(other->c_str());
+    }
+    // With at most 15 digits, both the digits and the power of ten are exactly representable as
+    // doubles, so a single division gives the correctly rounded result, which is the same result
+    // that parsing the text would give.
+    static constexpr double powers_of_ten[max_digits + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    double result = static_cast<double>(digits) / powers_of_ten[frac_digits];
+    return sign == '-' ? -result : result;
+}
@@ -1,6 +1,7 @@
 #include <qpdf/QPDFObjectHandle_private.hh>
 
 #include <qpdf/ContentNormalizer.hh>
+#include <qpdf/InputSource_private.hh>
 #include <qpdf/JSON_writer.hh>
 #include <qpdf/Pipeline.hh>
 #include <qpdf/Pipeline_private.hh>
@@ -11,6 +12,7 @@
 #include <qpdf/Pl_QPDFTokenizer.hh>
 #include <qpdf/QIntC.hh>
 #include <qpdf/QPDFExc.hh>
+#include <qpdf/QPDFStreamFilter_private.hh>
 #include <qpdf/QPDF_private.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
@@ -27,6 +29,43 @@ using namespace qpdf;
 
 using Streams = QPDF::Doc::Objects::Streams;
 
+namespace
+{
+    // Streams whose raw data is in memory and no larger than max_buffer_decode_size are decoded in
+    // one step if all their filters support it, which avoids the overhead of a chain of pipelines
+    // for the many small streams in typical files. Decoding in one step is abandoned in favour of
+    // the pipelines if the decoded data exceeds max_buffer_decoded_size.
+    constexpr size_t max_buffer_decode_size = 1 << 20;
+    constexpr size_t max_buffer_decoded_size = 1 << 24;
+
+    std::optional<std::string>
+    decode_buffer(
+        std::vector<std::shared_ptr<QPDFStreamFilter>> const& filters,
+        std::string_view data,
+        size_t size_hint)
+    {
+        std::vector<impl::BufferDecoder*> decoders;
+        for (auto const& filter: filters) {
+            auto decoder = dynamic_cast<impl::BufferDecoder*>(filter.get());
+            if (!decoder) {
+                return std::nullopt;
+            }
+            decoders.emplace_back(decoder);
+        }
+        std::string input;
+        std::string output;
+        for (auto decoder: decoders) {
+            bool last = decoder == decoders.back();
+            if (!decoder->decode(data, output, last ? size_hint : 0, max_buffer_decoded_size)) {
+                return std::nullopt;
+            }
+            input = std::move(output);
+            data = input;
+        }
+        return input;
+    }
+} // namespace
+
 class Streams::Copier final: public QPDFObjectHandle::StreamDataProvider
 {
     class Data
@@ -474,9 +513,40 @@ Stream::getStreamData(qpdf_stream_decode_level_e decode_level)
     return result;
 }
 
+std::optional<std::string_view>
+Streams::raw_data_view(QPDF* qpdf, qpdf_offset_t offset, size_t length)
+{
+    auto& m = *qpdf->m;
+    if (m.encp->encrypted) {
+        return std::nullopt;
+    }
+    auto data = is::view(*m.file, length, offset);
+    if (!data || data->size() != length) {
+        return std::nullopt;
+    }
+    return data;
+}
+
+std::optional<std::string_view>
+Stream::raw_data_view()
+{
+    auto s = stream();
+    if (s->stream_data) {
+        return std::string_view(
+            reinterpret_cast<char const*>(s->stream_data->getBuffer()), s->stream_data->getSize());
+    }
+    if (s->stream_provider || offset() == 0) {
+        return std::nullopt;
+    }
+    return Streams::raw_data_view(qpdf(), offset(), s->length);
+}
+
 std::string
 Stream::getRawStreamData()
 {
+    if (auto data = raw_data_view()) {
+        return std::string(*data);
+    }
     std::string result;
     pl::String buf(result);
     if (!pipeStreamData(&buf, nullptr, 0, qpdf_dl_none, false, false)) {
@@ -634,6 +704,7 @@ Stream::pipeStreamData(
     std::vector<std::unique_ptr<Pipeline>> to_delete;
 
     ContentNormalizer normalizer;
+    std::optional<std::string> decoded;
     if (filter) {
         if (encode_flags & qpdf_ef_compress) {
             auto new_pipeline =
@@ -656,7 +727,19 @@ Stream::pipeStreamData(
             to_delete.push_back(std::move(new_pipeline));
         }
 
-        for (auto f_iter = filters.rbegin(); f_iter != filters.rend(); ++f_iter) {
+        if (!filters.empty()) {
+            if (auto raw = raw_data_view(); raw && raw->size() <= max_buffer_decode_size) {
+                // /DL, if present, is the length of the decoded data.
+                size_t size_hint = 0;
+                if (Integer dl = s->stream_dict["/DL"];
+                    dl && dl > 0 && dl <= max_buffer_decoded_size) {
+                    size_hint = static_cast<size_t>(dl);
+                }
+                decoded = decode_buffer(filters, *raw, size_hint);
+            }
+        }
+
+        for (auto f_iter = filters.rbegin(); !decoded && f_iter != filters.rend(); ++f_iter) {
             if (auto decode_pipeline = (*f_iter)->getDecodePipeline(pipeline)) {
                 pipeline = decode_pipeline;
             }
@@ -667,7 +750,22 @@ Stream::pipeStreamData(
         }
     }
 
-    if (s->stream_data.get()) {
+    if (decoded) {
+        auto write = [&]() {
+            pipeline->write(
+                reinterpret_cast<unsigned char const*>(decoded->data()), decoded->size());
+        };
+        if (s->stream_data) {
+            // As below for replaced stream data
+            write();
+            pipeline->finish();
+        } else if (!Streams::pipe_data(
+                       qpdf(), id_gen(), pipeline, suppress_warnings, will_retry, write)) {
+            // As for data read from the input by Streams::pipeStreamData
+            filter = false;
+            return false;
+        }
+    } else if (s->stream_data.get()) {
         QTC::TC("qpdf", "QPDF_Stream pipe replaced stream data");
         pipeline->write(s->stream_data->getBuffer(), s->stream_data->getSize());
         pipeline->finish();
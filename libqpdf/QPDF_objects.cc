@@ -12,8 +12,10 @@
 #include <qpdf/QPDFParser.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/ReadAheadInputSource.hh>
 #include <qpdf/Util.hh>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstring>
@@ -126,18 +128,17 @@ class QPDF::ResolveRecorder final
 {
   public:
     ResolveRecorder(QPDF& qpdf, QPDFObjGen const& og) :
-        qpdf(qpdf),
-        iter(qpdf.m->resolving.insert(og).first)
+        qpdf(qpdf)
     {
+        qpdf.m->resolving.emplace_back(og);
     }
     ~ResolveRecorder()
     {
-        qpdf.m->resolving.erase(iter);
+        qpdf.m->resolving.pop_back();
     }
 
   private:
     QPDF& qpdf;
-    std::set<QPDFObjGen>::const_iterator iter;
 };
 
 class Objects::PatternFinder final: public InputSource::Finder
@@ -309,6 +310,94 @@ Objects::setTrailer(QPDFObjectHandle obj)
     m->trailer = obj;
 }
 
+namespace
+{
+    // Find the lines of a file that Objects::reconstruct_xref needs to tokenize. The file is
+    // scanned in blocks of 64 KiB, using views of in-memory inputs and reads otherwise. The current
+    // block is kept across calls to skip, so each byte of the file is read only once as long as the
+    // caller moves forward through the file.
+    class CandidateLineScanner
+    {
+      public:
+        CandidateLineScanner(InputSource& file, qpdf_offset_t eof) :
+            file(file),
+            eof(eof)
+        {
+        }
+
+        // Move file forward to the first character of the next line, starting with the current
+        // position, whose first token may be the object number of an object header, a trailer
+        // keyword if want_trailer is true, or a startxref keyword if want_startxref is true. Other
+        // lines are skipped without tokenizing them. Lines starting with a string or hex string,
+        // which may span several lines, are also treated as candidates so that the caller's
+        // tokenizer sees them. If there is no such line, leave file at eof.
+        void
+        skip(bool want_trailer, bool want_startxref)
+        {
+            auto pos = file.tell();
+            // Whether we are inside a line that has been rejected, including a comment.
+            bool in_line = false;
+            while (pos < eof) {
+                if (pos < block_start || pos >= block_start + QIntC::to_offset(block.size())) {
+                    if (!load(pos)) {
+                        break;
+                    }
+                }
+                auto const end = block.size();
+                auto i = QIntC::to_size(pos - block_start);
+                while (i < end) {
+                    if (in_line) {
+                        auto eol = block.find_first_of("\r\n", i);
+                        if (eol == std::string_view::npos) {
+                            i = end;
+                            break;
+                        }
+                        i = eol;
+                        in_line = false;
+                    }
+                    char ch = block[i];
+                    if (ch == '\0' || util::is_space(ch)) {
+                        ++i;
+                        continue;
+                    }
+                    if (util::is_digit(ch) || ch == '+' || ch == '-' || ch == '(' || ch == '<' ||
+                        (want_trailer && ch == 't') || (want_startxref && ch == 's')) {
+                        file.seek(block_start + QIntC::to_offset(i), SEEK_SET);
+                        return;
+                    }
+                    in_line = true;
+                }
+                pos = block_start + QIntC::to_offset(end);
+            }
+            file.seek(pos, SEEK_SET);
+        }
+
+      private:
+        // Make block the data of file starting at pos. Return false at eof.
+        bool
+        load(qpdf_offset_t pos)
+        {
+            auto size = static_cast<size_t>(std::min(eof - pos, QIntC::to_offset(block_size)));
+            if (auto view = is::view(file, size, pos)) {
+                block = *view;
+            } else {
+                file.read(buffer, size, pos);
+                block = buffer;
+            }
+            block_start = pos;
+            return !block.empty();
+        }
+
+        static constexpr size_t block_size = 1 << 16;
+
+        InputSource& file;
+        qpdf_offset_t const eof;
+        std::string buffer;
+        std::string_view block;
+        qpdf_offset_t block_start{0};
+    };
+} // namespace
+
 void
 Objects::reconstruct_xref(QPDFExc& e, bool found_startxref)
 {
@@ -350,18 +439,26 @@ Objects::reconstruct_xref(QPDFExc& e, bool found_startxref)
     std::vector<qpdf_offset_t> trailers;
     std::vector<qpdf_offset_t> startxrefs;
 
-    m->file->seek(0, SEEK_END);
-    qpdf_offset_t eof = m->file->tell();
-    m->file->seek(0, SEEK_SET);
+    // The scan below reads the whole file from front to back, so read ahead in large blocks if the
+    // file is not held in memory.
+    auto file = ReadAheadInputSource::create(m->file);
+    file->seek(0, SEEK_END);
+    qpdf_offset_t eof = file->tell();
+    file->seek(0, SEEK_SET);
     // Don't allow very long tokens here during recovery. All the interesting tokens are covered.
     static size_t const MAX_LEN = 10;
-    while (m->file->tell() < eof) {
-        QPDFTokenizer::Token t1 = m->objects.readToken(*m->file, MAX_LEN);
-        qpdf_offset_t token_start = m->file->tell() - toO(t1.getValue().length());
+    CandidateLineScanner scanner(*file, eof);
+    while (file->tell() < eof) {
+        scanner.skip(!m->trailer, !found_startxref);
+        if (file->tell() >= eof) {
+            break;
+        }
+        QPDFTokenizer::Token t1 = m->objects.readToken(*file, MAX_LEN);
+        qpdf_offset_t token_start = file->tell() - toO(t1.getValue().length());
         if (t1.isInteger()) {
-            auto pos = m->file->tell();
-            auto t2 = m->objects.readToken(*m->file, MAX_LEN);
-            if (t2.isInteger() && m->objects.readToken(*m->file, MAX_LEN).isWord("obj")) {
+            auto pos = file->tell();
+            auto t2 = m->objects.readToken(*file, MAX_LEN);
+            if (t2.isInteger() && m->objects.readToken(*file, MAX_LEN).isWord("obj")) {
                 int obj = QUtil::string_to_int(t1.getValue().c_str());
                 int gen = QUtil::string_to_int(t2.getValue().c_str());
                 if (obj <= m->xref_table_max_id) {
@@ -371,14 +468,14 @@ Objects::reconstruct_xref(QPDFExc& e, bool found_startxref)
                         "", -1, "ignoring object with impossibly large id " + std::to_string(obj)));
                 }
             }
-            m->file->seek(pos, SEEK_SET);
+            file->seek(pos, SEEK_SET);
         } else if (!m->trailer && t1.isWord("trailer")) {
-            trailers.emplace_back(m->file->tell());
+            trailers.emplace_back(file->tell());
         } else if (!found_startxref && t1.isWord("startxref")) {
-            startxrefs.emplace_back(m->file->tell());
+            startxrefs.emplace_back(file->tell());
         }
         check_warnings();
-        m->file->findAndSkipNextEOL();
+        file->findAndSkipNextEOL();
     }
 
     if (!found_startxref && !startxrefs.empty() && !found_objects.empty() &&
@@ -1222,7 +1319,44 @@ QPDF::showXRefTable()
 bool
 Objects::resolveXRefTable()
 {
+    // Resolve uncompressed objects in the order in which they appear in the file, followed by the
+    // objects in object streams, one object stream at a time in the order in which the object
+    // streams appear in the file. This reads the file sequentially and decodes each object stream
+    // once rather than jumping around the file in object id order. Finally, pick up anything left,
+    // such as objects with invalid xref entries, in object id order.
     bool may_change = !m->reconstructed_xref;
+    std::vector<std::pair<qpdf_offset_t, QPDFObjGen>> uncompressed;
+    std::map<int, QPDFObjGen> object_streams; // first member of each object stream
+    for (auto const& [og, entry]: m->xref_table) {
+        if (entry.getType() == 1) {
+            uncompressed.emplace_back(entry.getOffset(), og);
+        } else if (entry.getType() == 2) {
+            object_streams.try_emplace(entry.getObjStreamNumber(), og);
+        }
+    }
+    std::ranges::sort(uncompressed);
+    std::vector<std::pair<qpdf_offset_t, QPDFObjGen>> compressed;
+    compressed.reserve(object_streams.size());
+    for (auto const& [stream_id, og]: object_streams) {
+        auto stream = m->xref_table.find(QPDFObjGen(stream_id, 0));
+        compressed.emplace_back(
+            stream != m->xref_table.end() && stream->second.getType() == 1
+                ? stream->second.getOffset()
+                : std::numeric_limits<qpdf_offset_t>::max(),
+            og);
+    }
+    std::ranges::sort(compressed);
+
+    for (auto const* objects: {&uncompressed, &compressed}) {
+        for (auto const& [offset, og]: *objects) {
+            if (isUnresolved(og)) {
+                resolve(og);
+                if (may_change && m->reconstructed_xref) {
+                    return false;
+                }
+            }
+        }
+    }
     for (auto& iter: m->xref_table) {
         if (isUnresolved(iter.first)) {
             resolve(iter.first);
@@ -1662,7 +1796,7 @@ Objects::resolve(QPDFObjGen og)
         return m->obj_cache[og].object;
     }
 
-    if (m->resolving.contains(og)) {
+    if (std::ranges::find(m->resolving, og) != m->resolving.end()) {
         // This can happen if an object references itself directly or indirectly in some key that
         // has to be resolved during object parsing, such as stream length.
         warn(damagedPDF("", "loop detected resolving object " + og.unparse(' ')));
@@ -1947,6 +2081,25 @@ Objects::getObjectForJSON(int id, int gen)
     return obj;
 }
 
+std::shared_ptr<impl::LazySource>
+Objects::lazy_source(InputSource const& input)
+{
+    if (!cf.lazy_arrays() || &input != m->file.get()) {
+        return {};
+    }
+    if (!lazy_source_) {
+        lazy_source_ = std::make_shared<impl::LazySource>(&qpdf, m->file);
+    }
+    return lazy_source_;
+}
+
+Objects::~Objects()
+{
+    if (lazy_source_) {
+        lazy_source_->qpdf = nullptr;
+    }
+}
+
 QPDFObjectHandle
 QPDF::getObject(QPDFObjGen og)
 {
@@ -726,11 +726,12 @@ std::string
 QUtil::hex_encode(std::string const& input)
 {
     static auto constexpr hexchars = "0123456789abcdef";
-    std::string result;
-    result.reserve(2 * input.length());
-    for (const char c: input) {
-        result += hexchars[static_cast<unsigned char>(c) >> 4];
-        result += hexchars[c & 0x0f];
+    std::string result(2 * input.length(), '\0');
+    auto* p = result.data();
+    for (auto c: input) {
+        auto uc = static_cast<unsigned char>(c);
+        *p++ = hexchars[uc >> 4];
+        *p++ = hexchars[uc & 0x0f];
     }
     return result;
 }
@@ -742,9 +743,21 @@ QUtil::hex_decode(std::string const& input)
     // We know result.size() <= 0.5 * input.size() + 1. However, reserving string space for this
     // upper bound has a negative impact.
     bool first = true;
-    char decoded;
-    for (auto ch: input) {
-        ch = util::hex_decode_char(ch);
+    char decoded = 0;
+    auto const* p = input.data();
+    auto const* end = p + input.size();
+    while (p != end) {
+        if (first && end - p >= 2) {
+            // Decode pairs of hex digits directly.
+            auto high = util::hex_decode_table[static_cast<unsigned char>(p[0])];
+            auto low = util::hex_decode_table[static_cast<unsigned char>(p[1])];
+            if ((high | low) < '\20') {
+                result.push_back(static_cast<char>((high << 4) | low));
+                p += 2;
+                continue;
+            }
+        }
+        auto ch = util::hex_decode_table[static_cast<unsigned char>(*p++)];
         if (ch < '\20') {
             if (first) {
                 decoded = static_cast<char>(ch << 4);
@@ -0,0 +1,130 @@
+#include <qpdf/ReadAheadInputSource.hh>
+
+#include <qpdf/InputSource_private.hh>
+#include <qpdf/QIntC.hh>
+#include <qpdf/Util.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace qpdf;
+
+std::shared_ptr<InputSource>
+ReadAheadInputSource::create(std::shared_ptr<InputSource> proxied)
+{
+    if (is::in_memory(*proxied)) {
+        return proxied;
+    }
+    return std::make_shared<ReadAheadInputSource>(proxied);
+}
+
+ReadAheadInputSource::ReadAheadInputSource(
+    std::shared_ptr<InputSource> proxied, size_t read_ahead) :
+    proxied(proxied),
+    read_ahead(std::max(read_ahead, min_fill))
+{
+}
+
+bool
+ReadAheadInputSource::fill(size_t length)
+{
+    // Only read ahead if we are continuing where the last fill ended.
+    bool sequential = pos == buf_start + QIntC::to_offset(buf.size());
+    size_t size = std::max(length, sequential ? read_ahead : min_fill);
+    proxied->seek(pos, SEEK_SET);
+    buf.resize(size);
+    buf.resize(proxied->read(buf.data(), size));
+    buf_start = pos;
+    return !buf.empty();
+}
+
+qpdf_offset_t
+ReadAheadInputSource::findAndSkipNextEOL()
+{
+    auto is_eol = [](char ch) { return ch == '\r' || ch == '\n'; };
+    while (true) {
+        if (!buffered() && !fill(1)) {
+            return pos;
+        }
+        auto start = buf.begin() + (pos - buf_start);
+        auto p = std::find_if(start, buf.end(), is_eol);
+        pos += p - start;
+        if (p != buf.end()) {
+            break;
+        }
+    }
+    // We found \r or \n. Skip past any further \r and \n characters.
+    qpdf_offset_t result = pos++;
+    while ((buffered() || fill(1)) && is_eol(buf[QIntC::to_size(pos - buf_start)])) {
+        ++pos;
+    }
+    return result;
+}
+
+std::string const&
+ReadAheadInputSource::getName() const
+{
+    return proxied->getName();
+}
+
+qpdf_offset_t
+ReadAheadInputSource::tell()
+{
+    return pos;
+}
+
+void
+ReadAheadInputSource::seek(qpdf_offset_t offset, int whence)
+{
+    switch (whence) {
+    case SEEK_SET:
+        break;
+
+    case SEEK_END:
+        proxied->seek(offset, SEEK_END);
+        offset = proxied->tell();
+        break;
+
+    default:
+        util::assertion(whence == SEEK_CUR, "invalid argument to ReadAheadInputSource::seek");
+        QIntC::range_check(pos, offset);
+        offset += pos;
+    }
+    if (offset < 0) {
+        throw std::runtime_error(getName() + ": seek before beginning of file");
+    }
+    pos = offset;
+}
+
+void
+ReadAheadInputSource::rewind()
+{
+    pos = 0;
+}
+
+size_t
+ReadAheadInputSource::read(char* buffer, size_t length)
+{
+    last_offset = pos;
+    size_t done = 0;
+    while (done < length) {
+        if (!buffered() && !fill(length - done)) {
+            break;
+        }
+        auto offset = QIntC::to_size(pos - buf_start);
+        auto len = std::min(length - done, buf.size() - offset);
+        memcpy(buffer + done, buf.data() + offset, len);
+        done += len;
+        pos += QIntC::to_offset(len);
+    }
+    return done;
+}
+
+void
+ReadAheadInputSource::unreadCh(char)
+{
+    if (pos > 0) {
+        --pos;
+    }
+}
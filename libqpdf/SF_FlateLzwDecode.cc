@@ -1,5 +1,6 @@
 #include <qpdf/SF_FlateLzwDecode.hh>
 
+#include <qpdf/Pipeline_private.hh>
 #include <qpdf/Pl_Flate.hh>
 #include <qpdf/Pl_LZWDecoder.hh>
 #include <qpdf/Pl_PNGFilter.hh>
@@ -104,3 +105,40 @@ SF_FlateLzwDecode::getDecodePipeline(Pipeline* next)
     pipelines.push_back(std::move(pipeline));
     return next;
 }
+
+bool
+SF_FlateLzwDecode::decode(
+    std::string_view data, std::string& out, size_t size_hint, size_t max_size)
+{
+    if (lzw) {
+        return false;
+    }
+    if (predictor == 1) {
+        return qpdf::pl::inflate(data, out, size_hint, max_size);
+    }
+    std::string inflated;
+    if (!qpdf::pl::inflate(data, inflated, 0, max_size)) {
+        return false;
+    }
+    try {
+        if (predictor >= 10 && predictor <= 15) {
+            out = qpdf::pl::pipe<Pl_PNGFilter>(
+                inflated,
+                Pl_PNGFilter::a_decode,
+                QIntC::to_uint(columns),
+                QIntC::to_uint(colors),
+                QIntC::to_uint(bits_per_component));
+        } else {
+            out = qpdf::pl::pipe<Pl_TIFFPredictor>(
+                inflated,
+                Pl_TIFFPredictor::a_decode,
+                QIntC::to_uint(columns),
+                QIntC::to_uint(colors),
+                QIntC::to_uint(bits_per_component));
+        }
+    } catch (std::exception&) {
+        // Leave it to the decode pipeline to report the problem.
+        return false;
+    }
+    return true;
+}
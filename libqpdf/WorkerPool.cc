@@ -0,0 +1,42 @@
+#include <qpdf/WorkerPool.hh>
+
+using namespace qpdf;
+
+WorkerPool::WorkerPool(size_t threads)
+{
+    this->threads.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        this->threads.emplace_back([this] { run(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& thread: threads) {
+        thread.join();
+    }
+}
+
+void
+WorkerPool::run()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        // Exceptions are captured by the packaged_task and passed on through its future.
+        task();
+    }
+}
@@ -74,6 +74,12 @@ qpdf_global_get_uint32(qpdf_param_e param, uint32_t* value)
     case qpdf_p_limit_errors:
         *value = Limits::errors();
         return qpdf_r_ok;
+    case qpdf_p_closed_file_pool_size:
+        *value = Options::closed_file_pool_size();
+        return qpdf_r_ok;
+    case qpdf_p_mmap_input:
+        *value = Options::mmap_input();
+        return qpdf_r_ok;
     case qpdf_p_dct_throw_on_corrupt_data:
         *value = Options::dct_throw_on_corrupt_data();
         return qpdf_r_ok;
@@ -137,6 +143,12 @@ qpdf_global_set_uint32(qpdf_param_e param, uint32_t value)
     case qpdf_p_default_limits:
         Options::default_limits(value);
         return qpdf_r_ok;
+    case qpdf_p_closed_file_pool_size:
+        Options::closed_file_pool_size(value);
+        return qpdf_r_ok;
+    case qpdf_p_mmap_input:
+        Options::mmap_input(value);
+        return qpdf_r_ok;
     case qpdf_p_dct_throw_on_corrupt_data:
         Options::dct_throw_on_corrupt_data(value);
         return qpdf_r_ok;
@@ -0,0 +1,157 @@
+#ifndef QPDF_ATOM_HH
+#define QPDF_ATOM_HH
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// The standard PDF names that have atoms, without the leading '/', in byte order of the names.
+#define QPDF_ATOMS(X) X(A) X(AA) X(AESV2) X(AESV3) X(AIS) X(AP) X(AS) X(ASCII85Decode) \
+    X(ASCIIHexDecode) X(AcroForm) X(ActualText) X(Alternate) X(Annot) X(Annots) X(ArtBox) \
+    X(Ascent) X(Author) X(AvgWidth) X(B) X(BBox) X(BM) X(BS) X(Background) X(BaseEncoding) \
+    X(BaseFont) X(BaseVersion) X(BitsPerComponent) X(BitsPerCoordinate) X(BitsPerFlag) \
+    X(BitsPerSample) X(BlackIs1) X(BleedBox) X(Border) X(Bounds) X(Btn) X(ByteRange) X(C) X(C0) \
+    X(C1) X(CA) X(CCITTFaxDecode) X(CF) X(CFM) X(CIDFontType0) X(CIDFontType2) X(CIDSet) \
+    X(CIDSystemInfo) X(CIDToGIDMap) X(CMapName) X(CS) X(CapHeight) X(Catalog) X(Ch) X(CharProcs) \
+    X(CharSet) X(ColorSpace) X(Colors) X(Columns) X(Contents) X(Coords) X(Count) X(CreationDate) \
+    X(Creator) X(CropBox) X(Crypt) X(D) X(DA) X(DCTDecode) X(DP) X(DR) X(DV) X(DW) X(DW2) \
+    X(Decode) X(DecodeParms) X(DescendantFonts) X(Descent) X(Dest) X(Dests) X(DeviceCMYK) \
+    X(DeviceGray) X(DeviceN) X(DeviceRGB) X(Differences) X(Domain) X(E) X(EF) X(EarlyChange) \
+    X(EmbeddedFile) X(EmbeddedFiles) X(Encode) X(EncodedByteAlign) X(Encoding) X(Encrypt) \
+    X(EncryptMetadata) X(EndOfBlock) X(EndOfLine) X(ExtGState) X(Extend) X(ExtensionLevel) \
+    X(Extensions) X(F) X(FT) X(Ff) X(Fields) X(Filter) X(First) X(FirstChar) X(Flags) \
+    X(FlateDecode) X(Font) X(FontBBox) X(FontDescriptor) X(FontFamily) X(FontFile) X(FontFile2) \
+    X(FontFile3) X(FontMatrix) X(FontName) X(FontStretch) X(FontWeight) X(Form) X(FormType) \
+    X(Function) X(FunctionType) X(Functions) X(Group) X(H) X(Height) X(I) X(ID) X(Identity) \
+    X(Image) X(ImageB) X(ImageC) X(ImageI) X(ImageMask) X(Index) X(Info) X(Intent) X(Interpolate) \
+    X(ItalicAngle) X(JBIG2Decode) X(JBIG2Globals) X(JPXDecode) X(JS) X(JavaScript) X(K) \
+    X(Keywords) X(Kids) X(L) X(LZWDecode) X(Lang) X(LastChar) X(LastModified) X(Leading) X(Length) \
+    X(Length1) X(Length2) X(Length3) X(Limits) X(Linearized) X(Link) X(M) X(MK) X(MarkInfo) \
+    X(Mask) X(Matrix) X(MaxLen) X(MaxWidth) X(MediaBox) X(Metadata) X(MissingWidth) X(ModDate) \
+    X(N) X(Name) X(Names) X(NeedAppearances) X(Next) X(Nums) X(O) X(OC) X(OCGs) X(OCProperties) \
+    X(OE) X(ObjStm) X(Off) X(OpenAction) X(Ordering) X(Outlines) X(P) X(PDF) X(Page) X(PageLabels) \
+    X(PageLayout) X(PageMode) X(Pages) X(PaintType) X(Parent) X(Pattern) X(PatternType) X(Perms) \
+    X(Popup) X(Predictor) X(Prev) X(ProcSet) X(Producer) X(Properties) X(Q) X(R) X(Range) X(Rect) \
+    X(Registry) X(Resources) X(Root) X(Rotate) X(Rows) X(RunLengthDecode) X(S) X(SMask) X(Shading) \
+    X(ShadingType) X(Sig) X(SigFlags) X(Size) X(StdCF) X(StemH) X(StemV) X(StmF) X(StrF) \
+    X(StructParent) X(StructParents) X(StructTreeRoot) X(Subject) X(Subtype) X(Supplement) X(T) \
+    X(TU) X(Text) X(Threads) X(Title) X(ToUnicode) X(TrimBox) X(TrueType) X(Type) X(Type0) \
+    X(Type1) X(Type3) X(U) X(UE) X(UF) X(URI) X(UserUnit) X(V) X(Version) X(ViewerPreferences) \
+    X(W) X(W2) X(Widget) X(Widths) X(WinAnsiEncoding) X(XHeight) X(XObject) X(XRef) X(XRefStm) \
+    X(XStep) X(YStep)
+
+namespace qpdf
+{
+    // Atoms are compact ids for a fixed, process-wide table of standard PDF names that commonly
+    // occur as dictionary keys and values. Ids are assigned in byte order of the names, so the
+    // order of the ids of two atoms is the same as the order of their names. Names that are not in
+    // the table don't have an atom.
+    namespace atom
+    {
+        enum id : std::uint16_t {
+            none = 0,
+#define QPDF_ATOM_ID(name) name,
+            QPDF_ATOMS(QPDF_ATOM_ID)
+#undef QPDF_ATOM_ID
+            count
+        };
+
+        // Return the atom for name, which includes the leading '/', or none if name is not in the
+        // table.
+        id find(std::string_view name);
+
+        // Return the name of atom a, including the leading '/'. The name of none is empty.
+        std::string const& name(id a);
+    } // namespace atom
+
+    // A dictionary key. Key holds the name, including the leading '/', together with its atom so
+    // that keys of standard names can be compared by comparing their atoms. Keys are ordered like
+    // their names. A Key can't be modified after it has been created, so its atom always matches
+    // its name.
+    class Key final
+    {
+      public:
+        Key() = default;
+
+        explicit Key(std::string name) :
+            name_(std::move(name)),
+            atom_(atom::find(name_))
+        {
+        }
+
+        explicit Key(std::string_view name) :
+            Key(std::string(name))
+        {
+        }
+
+        explicit Key(char const* name) :
+            Key(std::string(name))
+        {
+        }
+
+        explicit Key(atom::id a) :
+            name_(atom::name(a)),
+            atom_(a)
+        {
+        }
+
+        std::string const&
+        name() const
+        {
+            return name_;
+        }
+
+        atom::id
+        atom() const
+        {
+            return atom_;
+        }
+
+        operator std::string const&() const
+        {
+            return name_;
+        }
+
+        friend bool
+        operator==(Key const& lhs, Key const& rhs)
+        {
+            if (lhs.atom_ || rhs.atom_) {
+                return lhs.atom_ == rhs.atom_;
+            }
+            return lhs.name_ == rhs.name_;
+        }
+
+        friend bool
+        operator==(Key const& lhs, std::string_view rhs)
+        {
+            return lhs.name_ == rhs;
+        }
+
+        friend bool
+        operator<(Key const& lhs, Key const& rhs)
+        {
+            if (lhs.atom_ && rhs.atom_) {
+                return lhs.atom_ < rhs.atom_;
+            }
+            return lhs.name_ < rhs.name_;
+        }
+
+        friend bool
+        operator<(Key const& lhs, std::string_view rhs)
+        {
+            return lhs.name_ < rhs;
+        }
+
+        friend bool
+        operator<(std::string_view lhs, Key const& rhs)
+        {
+            return lhs < rhs.name_;
+        }
+
+      private:
+        std::string name_;
+        atom::id atom_{atom::none};
+    };
+} // namespace qpdf
+
+#endif // QPDF_ATOM_HH
@@ -6,12 +6,50 @@
 #include <qpdf/Util.hh>
 
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 
 namespace qpdf::is
 {
-    class OffsetBuffer final: public InputSource
+    // Interface of input sources that can hand out views of their content instead of copying it.
+    // It is separate from InputSource so that InputSource's ABI is unchanged. Use is::in_memory and
+    // is::view rather than calling its methods directly.
+    class Memory
+    {
+      public:
+        virtual ~Memory() = default;
+
+        // Return true if the content of the input source is held in memory.
+        virtual bool in_memory() const = 0;
+
+        // Equivalent to read(count, at) except that the result is a view into memory rather than a
+        // copy. Must only be called if in_memory() returns true.
+        virtual std::string_view view(size_t count, qpdf_offset_t at = -1) = 0;
+    };
+
+    // Return true if the content of input is held in memory.
+    inline bool
+    in_memory(InputSource& input)
+    {
+        auto memory = dynamic_cast<Memory*>(&input);
+        return memory && memory->in_memory();
+    }
+
+    // Return a view of the data read(count, at) would return if the content of input is held in
+    // memory, and std::nullopt otherwise. If a view is returned, the position and last offset are
+    // updated as they would have been by read(count, at).
+    inline std::optional<std::string_view>
+    view(InputSource& input, size_t count, qpdf_offset_t at = -1)
+    {
+        auto memory = dynamic_cast<Memory*>(&input);
+        if (!memory || !memory->in_memory()) {
+            return std::nullopt;
+        }
+        return memory->view(count, at);
+    }
+
+    class OffsetBuffer final: public InputSource, public Memory
     {
       public:
         OffsetBuffer(
@@ -65,6 +103,14 @@ namespace qpdf::is
 
         size_t read(char* buffer, size_t length) final;
 
+        bool
+        in_memory() const final
+        {
+            return true;
+        }
+
+        std::string_view view(size_t count, qpdf_offset_t at = -1) final;
+
         void
         unreadCh(char ch) final
         {
@@ -154,4 +200,21 @@ InputSource::fastUnread(bool back)
     seek(last_offset, SEEK_SET);
 }
 
+inline std::string_view
+InputSource::fastView()
+{
+    // Return the characters in the buffer that have not yet been read with fastRead. The view is
+    // empty at the end of the buffer, in which case the next fastRead refills it.
+    return {buffer + buf_idx, static_cast<size_t>(buf_len - buf_idx)};
+}
+
+inline void
+InputSource::fastSkip(size_t count)
+{
+    // Skip count characters of the view returned by fastView as if they had been read with
+    // fastRead.
+    buf_idx += static_cast<qpdf_offset_t>(count);
+    last_offset += static_cast<qpdf_offset_t>(count);
+}
+
 #endif // QPDF_INPUTSOURCE_PRIVATE_HH
@@ -0,0 +1,53 @@
+#ifndef QPDF_MMAPINPUTSOURCE_HH
+#define QPDF_MMAPINPUTSOURCE_HH
+
+// This class implements an InputSource that maps an entire read-only file into memory and serves
+// all reads directly from the mapping. The file descriptor is closed as soon as the mapping has
+// been established.
+//
+// Unlike with FileInputSource, if another process truncates the file while it is mapped, reading
+// the part of the mapping beyond the new end of the file raises SIGBUS instead of reporting an
+// unexpected end of file.
+
+#include <qpdf/InputSource_private.hh>
+
+#include <memory>
+#include <string_view>
+
+class MmapInputSource final: public InputSource, public qpdf::is::Memory
+{
+  public:
+    // Return an InputSource for the named file. If the mmap_input global option is set, the file is
+    // a non-empty regular file, and memory mapping is supported and succeeds, return a
+    // MmapInputSource. Otherwise, return a FileInputSource, which also takes care of reporting
+    // errors opening the file.
+    static std::shared_ptr<InputSource> create(std::string const& filename);
+
+    MmapInputSource(MmapInputSource const&) = delete;
+    MmapInputSource& operator=(MmapInputSource const&) = delete;
+    ~MmapInputSource() final;
+
+    qpdf_offset_t findAndSkipNextEOL() final;
+    std::string const& getName() const final;
+    qpdf_offset_t tell() final;
+    void seek(qpdf_offset_t offset, int whence) final;
+    void rewind() final;
+    size_t read(char* buffer, size_t length) final;
+    void unreadCh(char ch) final;
+
+    bool
+    in_memory() const final
+    {
+        return true;
+    }
+
+    std::string_view view(size_t count, qpdf_offset_t at = -1) final;
+
+  private:
+    MmapInputSource(std::string const& filename, std::string_view data);
+
+    std::string_view data_;
+    qpdf::is::OffsetBuffer is;
+};
+
+#endif // QPDF_MMAPINPUTSOURCE_HH
@@ -0,0 +1,314 @@
+#ifndef QPDF_OBJGENMAP_HH
+#define QPDF_OBJGENMAP_HH
+
+#include <qpdf/QPDFObjGen.hh>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace qpdf
+{
+    // ObjGenMap is an ordered map keyed by QPDFObjGen for the tables that QPDF consults every time
+    // it resolves an object, such as the xref table and the object cache. Entries are kept in a
+    // std::map, which provides the ordering that callers rely on when iterating. In addition, the
+    // map keeps a dense index, a vector indexed by object id, that points to an entry for each id.
+    // Since nearly all objects have exactly one generation, most lookups are answered by the index
+    // without searching the tree.
+    //
+    // For every id below the size of the index, the index slot holds end() if and only if there is
+    // no entry for that id. The index only grows while the ids in the map are reasonably dense, so
+    // that very large ids from damaged files don't cause very large allocations. Lookups of ids
+    // beyond the index, and of generations other than the one the index points to, fall back to
+    // the tree.
+    //
+    // The interface is the subset of std::map's used by QPDF. All modifications must go through
+    // this interface so that the index stays in sync.
+    template <typename T>
+    class ObjGenMap
+    {
+        using map_type = std::map<QPDFObjGen, T>;
+
+      public:
+        using key_type = QPDFObjGen;
+        using mapped_type = T;
+        using value_type = typename map_type::value_type;
+        using size_type = size_t;
+        using iterator = typename map_type::iterator;
+        using const_iterator = typename map_type::const_iterator;
+        using reverse_iterator = typename map_type::reverse_iterator;
+        using const_reverse_iterator = typename map_type::const_reverse_iterator;
+
+        ObjGenMap() = default;
+
+        ObjGenMap(ObjGenMap const& other) :
+            entries(other.entries)
+        {
+            rebuild_index(other.index.size());
+        }
+
+        ObjGenMap&
+        operator=(ObjGenMap const& other)
+        {
+            if (this != &other) {
+                entries = other.entries;
+                rebuild_index(other.index.size());
+            }
+            return *this;
+        }
+
+        // Empty index slots hold the end iterator of the tree, which doesn't survive a move.
+        ObjGenMap(ObjGenMap&& other) :
+            entries(std::move(other.entries))
+        {
+            rebuild_index(other.index.size());
+            other.clear();
+        }
+
+        ObjGenMap&
+        operator=(ObjGenMap&& other)
+        {
+            if (this != &other) {
+                entries = std::move(other.entries);
+                rebuild_index(other.index.size());
+                other.clear();
+            }
+            return *this;
+        }
+        ~ObjGenMap() = default;
+
+        // Allow the map to be passed where a std::map is expected without allowing modifications.
+        std::map<QPDFObjGen, T> const&
+        map() const
+        {
+            return entries;
+        }
+
+        bool
+        empty() const
+        {
+            return entries.empty();
+        }
+
+        size_type
+        size() const
+        {
+            return entries.size();
+        }
+
+        iterator
+        begin()
+        {
+            return entries.begin();
+        }
+
+        iterator
+        end()
+        {
+            return entries.end();
+        }
+
+        const_iterator
+        begin() const
+        {
+            return entries.begin();
+        }
+
+        const_iterator
+        end() const
+        {
+            return entries.end();
+        }
+
+        const_iterator
+        cbegin() const
+        {
+            return entries.cbegin();
+        }
+
+        const_iterator
+        cend() const
+        {
+            return entries.cend();
+        }
+
+        reverse_iterator
+        rbegin()
+        {
+            return entries.rbegin();
+        }
+
+        reverse_iterator
+        rend()
+        {
+            return entries.rend();
+        }
+
+        const_reverse_iterator
+        rbegin() const
+        {
+            return entries.rbegin();
+        }
+
+        const_reverse_iterator
+        rend() const
+        {
+            return entries.rend();
+        }
+
+        const_reverse_iterator
+        crbegin() const
+        {
+            return entries.crbegin();
+        }
+
+        const_reverse_iterator
+        crend() const
+        {
+            return entries.crend();
+        }
+
+        iterator
+        find(QPDFObjGen og)
+        {
+            auto id = static_cast<size_t>(og.getObj());
+            if (og.getObj() >= 0 && id < index.size()) {
+                auto it = index[id];
+                if (it == entries.end() || it->first == og) {
+                    return it;
+                }
+            }
+            return entries.find(og);
+        }
+
+        const_iterator
+        find(QPDFObjGen og) const
+        {
+            return const_cast<ObjGenMap*>(this)->find(og);
+        }
+
+        bool
+        contains(QPDFObjGen og) const
+        {
+            return find(og) != entries.end();
+        }
+
+        const_iterator
+        upper_bound(QPDFObjGen og) const
+        {
+            return entries.upper_bound(og);
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool>
+        try_emplace(QPDFObjGen og, Args&&... args)
+        {
+            if (auto it = find(og); it != entries.end()) {
+                return {it, false};
+            }
+            auto it = entries.try_emplace(og, std::forward<Args>(args)...).first;
+            add_to_index(it);
+            return {it, true};
+        }
+
+        std::pair<iterator, bool>
+        insert(value_type const& value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        T&
+        operator[](QPDFObjGen og)
+        {
+            return try_emplace(og).first->second;
+        }
+
+        iterator
+        erase(iterator pos)
+        {
+            auto id = static_cast<size_t>(pos->first.getObj());
+            bool indexed = pos->first.getObj() >= 0 && id < index.size() && index[id] == pos;
+            auto next = entries.erase(pos);
+            if (indexed) {
+                // Point the slot at another generation of the same object if there is one.
+                auto obj = static_cast<int>(id);
+                auto other = entries.lower_bound(QPDFObjGen(obj, 0));
+                index[id] =
+                    other != entries.end() && other->first.getObj() == obj ? other : entries.end();
+            }
+            return next;
+        }
+
+        size_type
+        erase(QPDFObjGen og)
+        {
+            if (auto it = find(og); it != entries.end()) {
+                erase(it);
+                return 1;
+            }
+            return 0;
+        }
+
+        void
+        clear()
+        {
+            entries.clear();
+            index.clear();
+        }
+
+      private:
+        // Point the index slot for the id of a newly inserted entry at it, growing the index if
+        // the ids are dense enough.
+        void
+        add_to_index(iterator it)
+        {
+            if (it->first.getObj() < 0) {
+                return;
+            }
+            auto id = static_cast<size_t>(it->first.getObj());
+            if (id >= index.size()) {
+                if (id > 2 * entries.size() + min_index_size) {
+                    return;
+                }
+                auto old_size = index.size();
+                index.resize(
+                    std::max(id + 1, std::max(2 * old_size, min_index_size)), entries.end());
+                index_range(old_size);
+                return;
+            }
+            if (index[id] == entries.end()) {
+                index[id] = it;
+            }
+        }
+
+        // Fill the empty slots for ids from `from` to the size of the index from the tree.
+        void
+        index_range(size_t from)
+        {
+            for (auto it = entries.lower_bound(QPDFObjGen(static_cast<int>(from), 0));
+                 it != entries.end() && static_cast<size_t>(it->first.getObj()) < index.size();
+                 ++it) {
+                auto& slot = index[static_cast<size_t>(it->first.getObj())];
+                if (slot == entries.end()) {
+                    slot = it;
+                }
+            }
+        }
+
+        void
+        rebuild_index(size_t size)
+        {
+            index.assign(size, entries.end());
+            index_range(0);
+        }
+
+        static constexpr size_t min_index_size = 1024;
+
+        map_type entries;
+        std::vector<iterator> index;
+    };
+} // namespace qpdf
+
+#endif // QPDF_OBJGENMAP_HH
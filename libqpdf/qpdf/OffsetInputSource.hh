@@ -4,9 +4,9 @@
 // This class implements an InputSource that proxies for an underlying input source but offset a
 // specific number of bytes.
 
-#include <qpdf/InputSource.hh>
+#include <qpdf/InputSource_private.hh>
 
-class OffsetInputSource: public InputSource
+class OffsetInputSource: public InputSource, public qpdf::is::Memory
 {
   public:
     OffsetInputSource(std::shared_ptr<InputSource>, qpdf_offset_t global_offset);
@@ -20,6 +20,10 @@ class OffsetInputSource: public InputSource
     size_t read(char* buffer, size_t length) override;
     void unreadCh(char ch) override;
 
+    // The content is in memory if the content of the proxied input source is.
+    bool in_memory() const override;
+    std::string_view view(size_t count, qpdf_offset_t at = -1) override;
+
   private:
     std::shared_ptr<InputSource> proxied;
     qpdf_offset_t global_offset;
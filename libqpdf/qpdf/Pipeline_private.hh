@@ -6,8 +6,12 @@
 #include <qpdf/Pipeline.hh>
 
 #include <qpdf/Pl_Flate.hh>
+#include <qpdf/QIntC.hh>
+#include <qpdf/QUtil.hh>
 #include <qpdf/Util.hh>
 
+#include <cstdio>
+
 namespace qpdf::pl
 {
     class String final: public Pipeline
@@ -137,6 +141,159 @@ namespace qpdf::pl
         bool pass_immediately_to_next{false};
     };
 
+    // Collect small writes in a buffer and pass them to 'next' in large chunks. Writes that are at
+    // least as large as the buffer are passed to 'next' directly after flushing the buffer. The
+    // buffer is flushed when 'finish' is called.
+    class Buffered final: public Pipeline
+    {
+      public:
+        Buffered(
+            char const* identifier, std::unique_ptr<Pipeline> next, size_t size = default_size) :
+            Pipeline(identifier, next.get()),
+            link(std::move(next)),
+            size(size)
+        {
+            buffer.reserve(size);
+        }
+
+        ~Buffered() final = default;
+
+        void
+        write(unsigned char const* buf, size_t len) final
+        {
+            if (len < size - buffer.size()) {
+                buffer.append(reinterpret_cast<char const*>(buf), len);
+                return;
+            }
+            flush();
+            if (len < size) {
+                buffer.append(reinterpret_cast<char const*>(buf), len);
+            } else {
+                next()->write(buf, len);
+            }
+        }
+
+        void
+        finish() final
+        {
+            flush();
+            next()->finish();
+        }
+
+        static constexpr size_t default_size = 1 << 17;
+
+      private:
+        void
+        flush()
+        {
+            if (!buffer.empty()) {
+                next()->write(reinterpret_cast<unsigned char const*>(buffer.data()), buffer.size());
+                buffer.clear();
+            }
+        }
+
+        std::unique_ptr<Pipeline> link;
+        std::string buffer;
+        size_t size;
+    };
+
+    // Pipeline that keeps a copy of everything written to it so that any part of it can be written
+    // again later. Data is kept in memory up to 'memory_limit' bytes and in a temporary file beyond
+    // that. If the temporary file can't be created or written, the copy is abandoned and ok()
+    // returns false.
+    class Replay final: public Pipeline
+    {
+      public:
+        Replay(char const* identifier, size_t memory_limit = default_memory_limit) :
+            Pipeline(identifier, nullptr),
+            memory_limit(memory_limit)
+        {
+        }
+
+        ~Replay() final
+        {
+            if (file) {
+                fclose(file);
+            }
+        }
+
+        void
+        write(unsigned char const* buf, size_t len) final
+        {
+            if (!ok_ || !len) {
+                return;
+            }
+            if (!file && data.size() + len <= memory_limit) {
+                data.append(reinterpret_cast<char const*>(buf), len);
+                return;
+            }
+            if (!file) {
+                file = tmpfile();
+                if (!file) {
+                    abandon();
+                    return;
+                }
+            }
+            if (fwrite(buf, 1, len, file) != len) {
+                abandon();
+            }
+        }
+
+        void
+        finish() final
+        {
+        }
+
+        bool
+        ok() const
+        {
+            return ok_;
+        }
+
+        static constexpr size_t default_memory_limit = 64 << 20;
+
+        // Write the copied bytes from offset 'start' up to but not including offset 'end' to p.
+        void
+        replay(Pipeline& p, qpdf_offset_t start, qpdf_offset_t end)
+        {
+            auto const in_memory = QIntC::to_offset(data.size());
+            if (start < in_memory) {
+                auto len = std::min(end, in_memory) - start;
+                p.write(data.data() + start, QIntC::to_size(len));
+                start += len;
+            }
+            if (start >= end) {
+                return;
+            }
+            util::assertion(file, identifier + ": data not available for replay");
+            QUtil::seek(file, start - in_memory, SEEK_SET);
+            std::string buf(std::min(QIntC::to_size(end - start), size_t(1) << 16), '\0');
+            while (start < end) {
+                auto len =
+                    fread(buf.data(), 1, std::min(buf.size(), QIntC::to_size(end - start)), file);
+                if (len == 0) {
+                    QUtil::throw_system_error(identifier + ": reading replay data");
+                }
+                p.write(buf.data(), len);
+                start += QIntC::to_offset(len);
+            }
+        }
+
+      private:
+        void
+        abandon()
+        {
+            ok_ = false;
+            data.clear();
+            data.shrink_to_fit();
+        }
+
+        std::string data;
+        size_t memory_limit;
+        FILE* file{nullptr};
+        bool ok_{true};
+    };
+
     template <typename P, typename... Args>
     std::string
     pipe(std::string_view data, Args&&... args)
@@ -148,6 +305,13 @@ namespace qpdf::pl
         pl.finish();
         return result;
     }
+
+    // Set `out` to the result of inflating `data`, which must be a complete zlib stream, in one
+    // step. `size_hint`, if not 0, is the expected size of the result. Return false if the data is
+    // not a complete, valid zlib stream or inflates to more than `max_size` bytes or the Pl_Flate
+    // memory limit. Pl_Flate must then be used to recover what it can and to report problems.
+    // This uses libdeflate if it is enabled for inflating. Implemented in Pl_Flate.cc.
+    bool inflate(std::string_view data, std::string& out, size_t size_hint, size_t max_size);
 } // namespace qpdf::pl
 
 #endif // PIPELINE_PRIVATE_HH
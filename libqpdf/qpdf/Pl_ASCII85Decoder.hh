@@ -3,6 +3,8 @@
 
 #include <qpdf/Pipeline.hh>
 
+#include <string>
+
 class Pl_ASCII85Decoder final: public Pipeline
 {
   public:
@@ -13,11 +15,14 @@ class Pl_ASCII85Decoder final: public Pipeline
 
   private:
     void flush();
+    void write_output();
 
     unsigned char inbuf[5]{117, 117, 117, 117, 117};
     size_t pos{0};
     size_t eod{0};
     bool error{false};
+    // data decoded during the current call to write or finish
+    std::string output;
 };
 
 #endif // PL_ASCII85DECODER_HH
@@ -3,6 +3,8 @@
 
 #include <qpdf/Pipeline.hh>
 
+#include <string>
+
 class Pl_ASCIIHexDecoder final: public Pipeline
 {
   public:
@@ -13,10 +15,13 @@ class Pl_ASCIIHexDecoder final: public Pipeline
 
   private:
     void flush();
+    void write_output();
 
     char inbuf[3]{'0', '0', '\0'};
     size_t pos{0};
     bool eod{false};
+    // data decoded during the current call to write or finish
+    std::string output;
 };
 
 #endif // PL_ASCIIHEXDECODER_HH
@@ -18,8 +18,8 @@ class Pl_Base64 final: public Pipeline
   private:
     void decode_internal(std::string_view data);
     void encode_internal(std::string_view data);
-    void flush_decode();
-    void flush_encode();
+    void flush_decode(char*& out);
+    void flush_encode(char*& out);
     void reset();
 
     action_e action;
@@ -3,8 +3,9 @@
 
 #include <qpdf/Pipeline.hh>
 
-#include <qpdf/Buffer.hh>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <string>
 
 class Pl_LZWDecoder final: public Pipeline
 {
@@ -15,24 +16,35 @@ class Pl_LZWDecoder final: public Pipeline
     void finish() final;
 
   private:
-    void sendNextCode();
     void handleCode(unsigned int code);
     unsigned char getFirstChar(unsigned int code);
     void addToTable(unsigned char next);
+    void flush();
 
     // members used for converting bits to codes
-    unsigned char buf[3]{0, 0, 0};
+    unsigned int bits{0};
     unsigned int code_size{9};
-    unsigned int next_char_{0};
-    unsigned int byte_pos{0};
-    unsigned int bit_pos{0}; // left to right: 01234567
     unsigned int bits_available{0};
 
     // members used for handle LZW decompression
+
+    // Each table entry is the entry for its prefix code followed by one more character. Entries
+    // for codes below 256 are the single characters. Entries are never freed, so adding one to
+    // the table or resetting the table doesn't allocate.
+    struct Entry
+    {
+        std::uint16_t prefix{0};
+        std::uint16_t length{1};
+        unsigned char first{0};
+        unsigned char last{0};
+    };
+
     bool code_change_delta{false};
     bool eod{false};
-    std::vector<Buffer> table;
+    std::array<Entry, 4096> table;
+    unsigned int table_size{0}; // number of entries after codes 256 and 257
     unsigned int last_code{256};
+    std::string output;
 };
 
 #endif // PL_LZWDECODER_HH
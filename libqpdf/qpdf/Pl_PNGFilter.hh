@@ -4,6 +4,7 @@
 #include <qpdf/Pipeline.hh>
 
 #include <cstdint>
+#include <string>
 
 // This pipeline applies or reverses the application of a PNG filter as described in the PNG
 // specification.
@@ -40,7 +41,7 @@ class Pl_PNGFilter final: public Pipeline
     void processRow();
     void encodeRow();
     void decodeRow();
-    int PaethPredictor(int a, int b, int c);
+    void flush();
 
     action_e action;
     uint32_t bytes_per_row;
@@ -51,6 +52,9 @@ class Pl_PNGFilter final: public Pipeline
     std::shared_ptr<unsigned char> buf2;
     size_t pos{0};
     size_t incoming{0};
+    // Rows are collected here and passed on in larger chunks since rows are often very short. Large
+    // rows are passed on without being collected, so this never holds much more than 128 KB.
+    std::string output;
 };
 
 #endif // PL_PNGFILTER_HH
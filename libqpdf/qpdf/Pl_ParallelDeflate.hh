@@ -0,0 +1,56 @@
+#ifndef PL_PARALLELDEFLATE_HH
+#define PL_PARALLELDEFLATE_HH
+
+#include <qpdf/Pipeline.hh>
+
+#include <qpdf/WorkerPool.hh>
+
+#include <deque>
+#include <future>
+#include <string>
+
+// This pipeline creates a zlib stream like Pl_Flate with a_deflate, using the compression level set
+// with Pl_Flate::setCompressionLevel. The input is divided into blocks that are compressed
+// independently on the threads of a worker pool. Each block is compressed with the last 32 KiB of
+// the preceding block as a preset dictionary and ends on a byte boundary, so the compressed blocks
+// can be concatenated into a single deflate stream. The result is a valid zlib stream that is
+// typically very slightly larger than the one Pl_Flate creates. The pool must not be used by the
+// thread that writes to this pipeline, or a deadlock can occur.
+class Pl_ParallelDeflate final: public Pipeline
+{
+  public:
+    static constexpr size_t def_block_size = 1 << 20;
+
+    Pl_ParallelDeflate(
+        char const* identifier,
+        Pipeline* next,
+        qpdf::WorkerPool& workers,
+        size_t block_size = def_block_size);
+    ~Pl_ParallelDeflate() final = default;
+
+    void write(unsigned char const* data, size_t len) final;
+    void finish() final;
+
+  private:
+    struct Block
+    {
+        std::string data;
+        unsigned long adler{1};
+        size_t size{0};
+    };
+
+    static Block compress(std::string data, std::string dictionary, int level, bool last);
+    void dispatch(bool last);
+    void drain(size_t max_pending);
+
+    qpdf::WorkerPool& workers;
+    size_t block_size;
+    int level;
+    std::string block;
+    std::string dictionary;
+    std::deque<std::future<Block>> pending;
+    unsigned long adler{1};
+    bool header_written{false};
+};
+
+#endif // PL_PARALLELDEFLATE_HH
@@ -127,14 +127,13 @@ namespace qpdf
       public:
         // The following methods are not part of the public API.
         std::set<std::string> getKeys();
-        std::map<std::string, QPDFObjectHandle> const& getAsMap() const;
+        std::map<std::string, QPDFObjectHandle> getAsMap() const;
         void replace(std::string const& key, QPDFObjectHandle value);
 
-        using iterator = std::map<std::string, QPDFObjectHandle>::iterator;
-        using const_iterator = std::map<std::string, QPDFObjectHandle>::const_iterator;
-        using reverse_iterator = std::map<std::string, QPDFObjectHandle>::reverse_iterator;
-        using const_reverse_iterator =
-            std::map<std::string, QPDFObjectHandle>::const_reverse_iterator;
+        using iterator = QPDF_Dictionary::Items::iterator;
+        using const_iterator = QPDF_Dictionary::Items::const_iterator;
+        using reverse_iterator = QPDF_Dictionary::Items::reverse_iterator;
+        using const_reverse_iterator = QPDF_Dictionary::Items::const_reverse_iterator;
 
         iterator
         begin()
@@ -645,6 +644,17 @@ namespace qpdf
             bool will_retry);
         std::string getStreamData(qpdf_stream_decode_level_e level);
         std::string getRawStreamData();
+
+        /// @brief Returns a view of the raw stream data without copying it, if possible.
+        ///
+        /// A view is available if the stream data has been replaced with a buffer, or if the
+        /// stream data is read from an unencrypted input source whose content is held in memory,
+        /// such as a memory-mapped file or a buffer. The view is into memory owned by the stream or
+        /// the QPDF object and is invalidated if the stream data is replaced or the input source
+        /// is closed.
+        ///
+        /// @return A view of the raw stream data, or std::nullopt if no view is available.
+        std::optional<std::string_view> raw_data_view();
         void replaceStreamData(
             std::string&& data,
             QPDFObjectHandle const& filter,
@@ -963,7 +973,19 @@ namespace qpdf
 
 } // namespace qpdf
 
-inline QPDF_Dictionary::QPDF_Dictionary(std::map<std::string, QPDFObjectHandle>&& items) :
+inline QPDF_Dictionary::QPDF_Dictionary(std::map<std::string, QPDFObjectHandle> const& items)
+{
+    for (auto const& [key, value]: items) {
+        this->items.emplace_hint(this->items.end(), Key(key), value);
+    }
+}
+
+inline QPDF_Dictionary::QPDF_Dictionary(Items const& items) :
+    items(items)
+{
+}
+
+inline QPDF_Dictionary::QPDF_Dictionary(Items&& items) :
     items(std::move(items))
 {
 }
@@ -978,7 +1000,7 @@ QPDF_Null::create(
 }
 
 inline QPDF_Real::QPDF_Real(double value, int decimal_places, bool trim_trailing_zeroes) :
-    val(QUtil::double_to_string(value, decimal_places, trim_trailing_zeroes))
+    QPDF_Real(QUtil::double_to_string(value, decimal_places, trim_trailing_zeroes))
 {
 }
 
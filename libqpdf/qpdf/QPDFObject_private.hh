@@ -7,10 +7,12 @@
 #include <qpdf/Constants.h>
 #include <qpdf/Types.h>
 
+#include <qpdf/Atom.hh>
 #include <qpdf/JSON.hh>
 #include <qpdf/JSON_writer.hh>
 #include <qpdf/QPDF.hh>
 #include <qpdf/QPDFObjGen.hh>
+#include <qpdf/SmallMap.hh>
 
 #include <map>
 #include <memory>
@@ -36,7 +38,8 @@ namespace qpdf
     namespace impl
     {
         class Writer;
-    }
+        struct LazyElements;
+    } // namespace impl
 } // namespace qpdf
 
 class QPDF_Array final
@@ -46,6 +49,9 @@ class QPDF_Array final
     {
         size_t size{0};
         std::map<size_t, QPDFObjectHandle> elements;
+        // If set, the array was read lazily and elements that are missing from `elements` have not
+        // been parsed yet rather than being null. See qpdf::impl::Parser.
+        std::shared_ptr<qpdf::impl::LazyElements const> lazy;
     };
 
   public:
@@ -58,6 +64,16 @@ class QPDF_Array final
     QPDF_Array(QPDF_Array&&) = default;
     QPDF_Array& operator=(QPDF_Array&&) = default;
 
+    // If the array was read lazily, parse all elements that have not been parsed yet and convert
+    // the array to a regular array. Otherwise, do nothing.
+    void
+    materialize()
+    {
+        if (sp && sp->lazy) {
+            materialize_lazy();
+        }
+    }
+
   private:
     friend class QPDFObject;
     friend class qpdf::BaseHandle;
@@ -73,6 +89,11 @@ class QPDF_Array final
         elements(std::move(items))
     {
     }
+    QPDF_Array(std::shared_ptr<qpdf::impl::LazyElements const> lazy);
+
+    // Return element n of a lazily read array, parsing it if necessary. n must be less than size().
+    QPDFObjectHandle const& lazy_element(size_t n);
+    void materialize_lazy();
 
     size_t
     size() const
@@ -107,13 +128,18 @@ class QPDF_Dictionary final
     friend class qpdf::BaseDictionary;
     friend class qpdf::BaseHandle;
 
-    QPDF_Dictionary(std::map<std::string, QPDFObjectHandle> const& items) :
-        items(items)
-    {
-    }
-    inline QPDF_Dictionary(std::map<std::string, QPDFObjectHandle>&& items);
+  public:
+    // Dictionary entries are keyed on qpdf::Key so that keys of standard names are compared by
+    // atom. The comparator is transparent, so entries can be looked up by std::string without
+    // creating a Key. Most dictionaries are small, so entries are kept in a SmallMap.
+    using Items = qpdf::SmallMap<qpdf::Key, QPDFObjectHandle>;
 
-    std::map<std::string, QPDFObjectHandle> items;
+  private:
+    inline QPDF_Dictionary(std::map<std::string, QPDFObjectHandle> const& items);
+    inline QPDF_Dictionary(Items const& items);
+    inline QPDF_Dictionary(Items&& items);
+
+    Items items;
 };
 
 class QPDF_InlineImage final
@@ -189,13 +215,34 @@ class QPDF_Real final
     friend class QPDFObjectHandle;
     friend class qpdf::BaseHandle;
 
-    QPDF_Real(std::string val) :
-        val(std::move(val))
-    {
-    }
+  public:
+    QPDF_Real(QPDF_Real const&);
+    QPDF_Real(QPDF_Real&&) noexcept = default;
+    QPDF_Real& operator=(QPDF_Real const&);
+    QPDF_Real& operator=(QPDF_Real&&) noexcept = default;
+    ~QPDF_Real() = default;
+
+    // Return the text of the real exactly as it was parsed or created.
+    std::string text() const;
+    double value() const;
+
+  private:
+    QPDF_Real(std::string_view val);
     inline QPDF_Real(double value, int decimal_places, bool trim_trailing_zeroes);
-    // Store reals as strings to avoid roundoff errors.
-    std::string val;
+
+    // Store reals so that their text can be recreated exactly to avoid roundoff errors. Reals of
+    // the form [+|-]ddd.ddd with at most max_digits digits, which covers almost all reals found in
+    // PDF files, are stored as the value of their digits together with the layout of their text.
+    // This needs no memory allocation, and the value of such reals can be calculated exactly
+    // without parsing their text. Anything else is kept as text in `other`.
+    static constexpr size_t max_digits = 15;
+
+    int64_t digits{0};
+    uint8_t int_digits{0};  // digits before the point, including leading zeros
+    uint8_t frac_digits{0}; // digits after the point
+    char sign{0};           // '+', '-' or 0 if there is no sign
+    bool point{false};
+    std::unique_ptr<std::string> other;
 };
 
 class QPDF_Reference
@@ -15,6 +15,39 @@ using namespace qpdf::global;
 
 namespace qpdf::impl
 {
+    /// @brief The input source from which a QPDF reads arrays lazily.
+    /// @par
+    ///         The source is shared by all lazily read arrays of a QPDF object. When the QPDF
+    ///         object is destroyed, qpdf is set to nullptr, and indirect references that have not
+    ///         been parsed yet become destroyed objects.
+    struct LazySource
+    {
+        QPDF* qpdf;                         ///< The QPDF the arrays belong to, or nullptr
+        std::shared_ptr<InputSource> input; ///< The input source the arrays were read from
+    };
+
+    /// @brief The elements of a lazily read array.
+    /// @par
+    ///         When reading an array lazily, the parser records the offset of each element and the
+    ///         values of integers and indirect references. Other elements are parsed from the input
+    ///         when they are first accessed.
+    struct LazyElements
+    {
+        enum kind_e : uint8_t { k_integer, k_reference, k_other };
+
+        struct Element
+        {
+            qpdf_offset_t offset; ///< Offset of the element's first token
+            long long value;      ///< Value of an integer or object id of a reference
+            int gen;              ///< Generation of a reference
+            kind_e kind;          ///< Kind of element
+        };
+
+        std::shared_ptr<LazySource> source;
+        std::shared_ptr<QPDFObject::Description> description;
+        std::vector<Element> elements;
+    };
+
     /// @class  Parser
     /// @brief  Internal parser for PDF objects and content streams.
     /// @par
@@ -101,6 +134,12 @@ namespace qpdf::impl
             qpdf::Tokenizer& tokenizer,
             QPDF& context);
 
+        /// @brief Parse an element of a lazily read array.
+        /// @param lazy The elements of the array.
+        /// @param n The index of the element to parse.
+        /// @return The parsed element.
+        static QPDFObjectHandle parse_lazy(LazyElements const& lazy, size_t n);
+
         /// @brief Create a description for a parsed object.
         /// @param input_name The name of the input source.
         /// @param object_description Description of the object being parsed.
@@ -163,9 +202,9 @@ namespace qpdf::impl
             }
 
             std::vector<QPDFObjectHandle> olist;          ///< Object list for arrays/dict values
-            std::map<std::string, QPDFObjectHandle> dict; ///< Dictionary entries
+            QPDF_Dictionary::Items dict;                  ///< Dictionary entries
             parser_state_e state;                         ///< Current parser state
-            std::string key;                              ///< Current dictionary key
+            Key key;                                      ///< Current dictionary key
             qpdf_offset_t offset;                         ///< Offset of container start
             std::string contents_string;                  ///< For /Contents field in signatures
             qpdf_offset_t contents_offset{-1};            ///< Offset of /Contents value
@@ -187,6 +226,15 @@ namespace qpdf::impl
         /// @return The completed object handle.
         QPDFObjectHandle parse_remainder(bool content_stream);
 
+        /// @brief Try to read an array lazily.
+        /// @par
+        ///         Called after reading an array open token. If lazy reading is enabled and the
+        ///         array is long and only contains scalars and indirect references, record its
+        ///         elements without parsing them.
+        /// @return The array, or nullptr if the array must be parsed normally, in which case the
+        ///         input is positioned after the array open token.
+        std::shared_ptr<QPDFObject> lazy_array();
+
         /// @brief Add an object to the current container.
         /// @param obj The object to add.
         void add(std::shared_ptr<QPDFObject>&& obj);
@@ -256,6 +304,7 @@ namespace qpdf::impl
         qpdf::Tokenizer& tokenizer_;                   ///< Tokenizer for lexical analysis
         QPDFObjectHandle::StringDecrypter* decrypter_; ///< Decrypter for encrypted strings
         QPDF* context_;                                ///< QPDF context for object resolution
+        std::shared_ptr<LazySource> lazy_; ///< Source for lazily read arrays, or nullptr
         std::shared_ptr<QPDFObject::Description> description_; ///< Shared description for objects
         bool parse_pdf_{false};     ///< True if parsing PDF objects vs content streams
         int stream_id_{0};          ///< Object stream ID (for object stream parsing)
@@ -0,0 +1,30 @@
+#ifndef QPDFSTREAMFILTER_PRIVATE_HH
+#define QPDFSTREAMFILTER_PRIVATE_HH
+
+#include <qpdf/QPDFStreamFilter.hh>
+
+#include <string>
+#include <string_view>
+
+namespace qpdf::impl
+{
+    // Stream filters that can decode data held in memory in a single step derive from
+    // BufferDecoder in addition to QPDFStreamFilter. This avoids the per-pipeline overhead of
+    // decoding small streams through a chain of pipelines. It is kept separate from
+    // QPDFStreamFilter so that adding it doesn't change the ABI of the public class.
+    class BufferDecoder
+    {
+      public:
+        virtual ~BufferDecoder() = default;
+
+        // Set `out` to the result of decoding `data`. As with getDecodePipeline, setDecodeParms
+        // has been called before. `size_hint`, if not 0, is the expected size of the decoded data.
+        // Return false if the data can't be decoded cleanly in one step or decodes to more than
+        // `max_size` bytes. The caller then decodes the data with the decode pipeline, which
+        // recovers what it can and reports any problems.
+        virtual bool
+        decode(std::string_view data, std::string& out, size_t size_hint, size_t max_size) = 0;
+    };
+} // namespace qpdf::impl
+
+#endif // QPDFSTREAMFILTER_PRIVATE_HH
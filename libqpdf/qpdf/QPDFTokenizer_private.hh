@@ -71,6 +71,17 @@ namespace qpdf
                 ? this->val
                 : this->raw_val;
         }
+        // Return the value of a tt_integer token. The value is accumulated while the token is
+        // scanned, so no conversion from the token's text is needed. Throw std::range_error if the
+        // value doesn't fit in a long long.
+        inline long long
+        getIntValue() const
+        {
+            if (int_overflow) {
+                return intOverflow();
+            }
+            return static_cast<long long>(int_negative ? 0 - int_magnitude : int_magnitude);
+        }
         inline std::string const&
         getRawValue() const
         {
@@ -86,6 +97,7 @@ namespace qpdf
         bool isSpace(char);
         bool isDelimiter(char);
         void findEI(InputSource& input);
+        void scanRun(InputSource& input, qpdf_offset_t& offset, size_t max_len);
 
         enum state_e {
             st_top,
@@ -137,6 +149,22 @@ namespace qpdf
         void inReal(char);
         void reset();
 
+        inline void
+        addDigit(char ch)
+        {
+            // Accumulate the magnitude of an integer, noting rather than reporting overflow since
+            // the token may turn out not to be an integer.
+            static constexpr unsigned long long max_magnitude = 9223372036854775807ULL;
+            auto digit = static_cast<unsigned long long>(ch - '0');
+            auto limit = int_negative ? max_magnitude + 1 : max_magnitude;
+            if (int_magnitude > (limit - digit) / 10) {
+                int_overflow = true;
+            } else {
+                int_magnitude = 10 * int_magnitude + digit;
+            }
+        }
+        long long intOverflow() const;
+
         // Lexer state
         state_e state;
 
@@ -154,6 +182,11 @@ namespace qpdf
         size_t inline_image_bytes;
         bool bad;
 
+        // State for integers
+        unsigned long long int_magnitude;
+        bool int_negative;
+        bool int_overflow;
+
         // State for strings
         int string_depth;
         int char_code;
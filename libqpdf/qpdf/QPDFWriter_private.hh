@@ -127,6 +127,8 @@ namespace qpdf
                 return direct_stream_lengths_;
             }
 
+            Config& direct_stream_lengths(bool val);
+
             bool
             newline_before_endstream() const
             {
@@ -153,6 +155,32 @@ namespace qpdf
                 return *this;
             }
 
+            size_t
+            compression_threads() const
+            {
+                return compression_threads_;
+            }
+
+            Config&
+            compression_threads(size_t val)
+            {
+                compression_threads_ = val;
+                return *this;
+            }
+
+            size_t
+            deflate_block_size() const
+            {
+                return deflate_block_size_;
+            }
+
+            Config&
+            deflate_block_size(size_t val)
+            {
+                deflate_block_size_ = val;
+                return *this;
+            }
+
             Config& stream_data(qpdf_stream_data_e val);
 
             std::string const&
@@ -297,6 +325,8 @@ namespace qpdf
             qpdf_stream_decode_level_e decode_level_{qpdf_dl_generalized};
 
             int forced_extension_level_{0};
+            size_t compression_threads_{0};
+            size_t deflate_block_size_{0};
 
             bool normalize_content_set_{false};
             bool normalize_content_{false};
@@ -336,6 +366,8 @@ struct QPDFWriter::Object
     int renumber{0};
     int gen{0};
     int object_stream{0};
+    int page{0};          // sequence number if the object is a page
+    int contents_page{0}; // sequence number of the page if the object is a page content stream
 };
 
 struct QPDFWriter::NewObject
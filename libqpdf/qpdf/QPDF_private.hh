@@ -7,6 +7,7 @@
 #include <qpdf/QPDFAcroFormDocumentHelper.hh>
 #include <qpdf/QPDFEmbeddedFileDocumentHelper.hh>
 #include <qpdf/QPDFLogger.hh>
+#include <qpdf/ObjGenMap.hh>
 #include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDFOutlineDocumentHelper.hh>
 #include <qpdf/QPDFPageDocumentHelper.hh>
@@ -16,6 +17,8 @@
 
 #include <cinttypes>
 #include <exception>
+#include <functional>
+#include <optional>
 
 using namespace qpdf;
 
@@ -30,6 +33,7 @@ namespace qpdf
     namespace impl
     {
         class AcroForm;
+        struct LazySource;
         using Doc = QPDF::Doc;
     } // namespace impl
 
@@ -135,6 +139,19 @@ namespace qpdf
                 return *this;
             }
 
+            bool
+            lazy_arrays() const
+            {
+                return lazy_arrays_;
+            }
+
+            Config&
+            lazy_arrays(bool val)
+            {
+                lazy_arrays_ = val;
+                return *this;
+            }
+
             bool
             check_mode() const
             {
@@ -157,6 +174,7 @@ namespace qpdf
             bool surpress_recovery_{false};
             bool check_mode_{false};
             bool immediate_copy_from_{false};
+            bool lazy_arrays_{false};
         }; // Class Config
     }; // class Doc
 } // namespace qpdf
@@ -305,6 +323,22 @@ class QPDF::Doc
             }
         }
 
+        // While a HoldWarnings object exists, warnings are appended to `held` instead of being
+        // issued. The caller can issue them later by passing them to warn.
+        class HoldWarnings
+        {
+          public:
+            HoldWarnings() = delete;
+            HoldWarnings(HoldWarnings const&) = delete;
+            HoldWarnings& operator=(HoldWarnings const&) = delete;
+            inline HoldWarnings(Common& common, std::vector<QPDFExc>& held);
+            inline ~HoldWarnings();
+
+          private:
+            QPDF::Members* m;
+            std::vector<QPDFExc>* previous;
+        };
+
       protected:
         // Type conversion helper methods
         template <typename T>
@@ -971,6 +1005,31 @@ class QPDF::Doc::Objects: Common
                 will_retry);
         }
 
+        // Call write to pass stream data of object og to pipeline, then finish the pipeline. If
+        // this throws, report the problem as a warning unless suppress_warnings is true, make sure
+        // the pipeline is finished, and return false. This is the error handling of
+        // QPDF::pipeStreamData for data that has been obtained by other means.
+        static bool pipe_data(
+            QPDF& qpdf_for_warning,
+            InputSource& file,
+            QPDFObjGen og,
+            Pipeline* pipeline,
+            bool suppress_warnings,
+            bool will_retry,
+            std::function<void()> const& write);
+        static bool pipe_data(
+            QPDF* qpdf,
+            QPDFObjGen og,
+            Pipeline* pipeline,
+            bool suppress_warnings,
+            bool will_retry,
+            std::function<void()> const& write);
+
+        // Return a view of length bytes of raw stream data at offset, or std::nullopt if the file
+        // is encrypted or its content is not held in memory.
+        static std::optional<std::string_view>
+        raw_data_view(QPDF* qpdf, qpdf_offset_t offset, size_t length);
+
         std::shared_ptr<Copier>&
         copier()
         {
@@ -989,7 +1048,7 @@ class QPDF::Doc::Objects: Common
     Objects(Objects&&) = delete;
     Objects& operator=(Objects const&) = delete;
     Objects& operator=(Objects&&) = delete;
-    ~Objects() = default;
+    ~Objects();
 
     Objects(Doc& doc) :
         Common(doc),
@@ -1010,6 +1069,10 @@ class QPDF::Doc::Objects: Common
         return streams_;
     }
 
+    // Return the source for arrays read lazily from input, or nullptr if arrays read from input
+    // must be parsed immediately.
+    std::shared_ptr<impl::LazySource> lazy_source(InputSource const& input);
+
     // actual value from file
     qpdf_offset_t
     first_xref_item_offset() const
@@ -1058,7 +1121,7 @@ class QPDF::Doc::Objects: Common
 
     // For QPDFWriter:
 
-    std::map<QPDFObjGen, QPDFXRefEntry> const& xref_table();
+    ObjGenMap<QPDFXRefEntry> const& xref_table();
     std::vector<QPDFObjGen> compressible_vector();
     std::vector<bool> compressible_set();
 
@@ -1114,6 +1177,7 @@ class QPDF::Doc::Objects: Common
 
     Foreign foreign_;
     Streams streams_;
+    std::shared_ptr<impl::LazySource> lazy_source_;
 
     // Linearization data
     qpdf_offset_t first_xref_item_offset_{0}; // actual value from file
@@ -1249,15 +1313,18 @@ class QPDF::Members: Doc
     std::shared_ptr<QPDFObject::Description> last_ostream_description;
     std::shared_ptr<EncryptionParameters> encp;
     std::string pdf_version;
-    std::map<QPDFObjGen, QPDFXRefEntry> xref_table;
+    ObjGenMap<QPDFXRefEntry> xref_table;
     // Various tables are indexed by object id, with potential size id + 1
     int xref_table_max_id{std::numeric_limits<int>::max() - 1};
     qpdf_offset_t xref_table_max_offset{0};
     std::set<int> deleted_objects;
-    std::map<QPDFObjGen, ObjCache> obj_cache;
-    std::set<QPDFObjGen> resolving;
+    ObjGenMap<ObjCache> obj_cache;
+    // Objects currently being resolved, innermost last.
+    std::vector<QPDFObjGen> resolving;
     QPDFObjectHandle trailer;
     std::vector<QPDFExc> warnings;
+    // If not null, warnings are collected here instead. See Common::HoldWarnings.
+    std::vector<QPDFExc>* held_warnings{nullptr};
     bool reconstructed_xref{false};
     bool in_read_xref_stream{false};
     bool fixed_dangling_refs{false};
@@ -1295,6 +1362,18 @@ inline QPDF::Doc::Common::Common(Doc& doc) :
 {
 }
 
+inline QPDF::Doc::Common::HoldWarnings::HoldWarnings(Common& common, std::vector<QPDFExc>& held) :
+    m(common.m),
+    previous(m->held_warnings)
+{
+    m->held_warnings = &held;
+}
+
+inline QPDF::Doc::Common::HoldWarnings::~HoldWarnings()
+{
+    m->held_warnings = previous;
+}
+
 inline QPDF::Doc::Linearization&
 QPDF::Doc::linearization()
 {
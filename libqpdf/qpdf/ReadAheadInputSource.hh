@@ -0,0 +1,61 @@
+#ifndef QPDF_READAHEADINPUTSOURCE_HH
+#define QPDF_READAHEADINPUTSOURCE_HH
+
+// This class implements an InputSource decorator for scans that run through the input from front
+// to back. Reads are served from a buffer. When a read continues where the previous buffer fill
+// ended, the buffer is refilled with a large block in a single read from the underlying source;
+// other reads only fetch a small block. This avoids issuing many small reads, and the seeks that
+// go with them, against slow storage while keeping the cost of random access low.
+
+#include <qpdf/InputSource.hh>
+
+#include <memory>
+#include <string>
+
+class ReadAheadInputSource final: public InputSource
+{
+  public:
+    // Return an InputSource suitable for a sequential scan of proxied. If proxied is held in
+    // memory, return it unchanged. Otherwise, return a ReadAheadInputSource wrapping it. The
+    // position of the returned input source is unspecified, so callers must seek before reading.
+    static std::shared_ptr<InputSource> create(std::shared_ptr<InputSource> proxied);
+
+    // The initial position is 0, regardless of the position of proxied.
+    ReadAheadInputSource(
+        std::shared_ptr<InputSource> proxied, size_t read_ahead = default_read_ahead);
+
+    ReadAheadInputSource(ReadAheadInputSource const&) = delete;
+    ReadAheadInputSource& operator=(ReadAheadInputSource const&) = delete;
+    ~ReadAheadInputSource() final = default;
+
+    qpdf_offset_t findAndSkipNextEOL() final;
+    std::string const& getName() const final;
+    qpdf_offset_t tell() final;
+    void seek(qpdf_offset_t offset, int whence) final;
+    void rewind() final;
+    size_t read(char* buffer, size_t length) final;
+    void unreadCh(char ch) final;
+
+    static constexpr size_t default_read_ahead = 1 << 20;
+
+  private:
+    static constexpr size_t min_fill = 8192;
+
+    bool
+    buffered() const
+    {
+        return pos >= buf_start && pos < buf_start + static_cast<qpdf_offset_t>(buf.size());
+    }
+
+    // Make pos available in the buffer, reading at least length bytes if available. Return false
+    // at EOF.
+    bool fill(size_t length);
+
+    std::shared_ptr<InputSource> proxied;
+    size_t read_ahead;
+    std::string buf;
+    qpdf_offset_t buf_start{0};
+    qpdf_offset_t pos{0};
+};
+
+#endif // QPDF_READAHEADINPUTSOURCE_HH
@@ -1,11 +1,11 @@
-#include <qpdf/QPDFStreamFilter.hh>
+#include <qpdf/QPDFStreamFilter_private.hh>
 #include <memory>
 #include <vector>
 
 #ifndef SF_FLATELZWDECODE_HH
 # define SF_FLATELZWDECODE_HH
 
-class SF_FlateLzwDecode final: public QPDFStreamFilter
+class SF_FlateLzwDecode final: public QPDFStreamFilter, public qpdf::impl::BufferDecoder
 {
   public:
     SF_FlateLzwDecode(bool lzw) :
@@ -16,6 +16,8 @@ class SF_FlateLzwDecode final: public QPDFStreamFilter
 
     bool setDecodeParms(QPDFObjectHandle decode_parms) final;
     Pipeline* getDecodePipeline(Pipeline* next) final;
+    bool
+    decode(std::string_view data, std::string& out, size_t size_hint, size_t max_size) final;
 
     static std::shared_ptr<QPDFStreamFilter>
     flate_factory()
@@ -0,0 +1,342 @@
+#ifndef QPDF_SMALLMAP_HH
+#define QPDF_SMALLMAP_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace qpdf
+{
+    // SmallMap is an ordered associative container for maps that usually have only a few entries,
+    // such as the entries of PDF dictionaries. Up to max_flat entries are kept in a sorted vector,
+    // which needs a single allocation and has good locality. When an insertion would take the map
+    // beyond max_flat entries, the entries are moved to a tree, which the map keeps using from then
+    // on.
+    //
+    // The interface is a subset of std::map's. Entries have a key that can't be modified and a
+    // mutable value, so all iterators are constant iterators through which values, but not keys,
+    // can be modified. Inserting or erasing entries invalidates all iterators while the map is
+    // flat. Lookups accept any type that Compare can compare with Key.
+    template <typename Key, typename T, typename Compare = std::less<>, size_t max_flat = 16>
+    class SmallMap
+    {
+      public:
+        struct value_type
+        {
+            Key first;
+            mutable T second;
+        };
+
+        using key_type = Key;
+        using mapped_type = T;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+
+      private:
+        struct entry_compare
+        {
+            using is_transparent = void;
+
+            bool
+            operator()(value_type const& lhs, value_type const& rhs) const
+            {
+                return Compare()(lhs.first, rhs.first);
+            }
+
+            template <typename K>
+            bool
+            operator()(value_type const& lhs, K const& rhs) const
+            {
+                return Compare()(lhs.first, rhs);
+            }
+
+            template <typename K>
+            bool
+            operator()(K const& lhs, value_type const& rhs) const
+            {
+                return Compare()(lhs, rhs.first);
+            }
+        };
+
+        using flat_type = std::vector<value_type>;
+        using tree_type = std::set<value_type, entry_compare>;
+
+      public:
+        class const_iterator
+        {
+          public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = SmallMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type const*;
+            using reference = value_type const&;
+
+            const_iterator() = default;
+
+            reference
+            operator*() const
+            {
+                return in_tree ? *t : *f;
+            }
+
+            pointer
+            operator->() const
+            {
+                return &**this;
+            }
+
+            const_iterator&
+            operator++()
+            {
+                if (in_tree) {
+                    ++t;
+                } else {
+                    ++f;
+                }
+                return *this;
+            }
+
+            const_iterator
+            operator++(int)
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            const_iterator&
+            operator--()
+            {
+                if (in_tree) {
+                    --t;
+                } else {
+                    --f;
+                }
+                return *this;
+            }
+
+            const_iterator
+            operator--(int)
+            {
+                auto result = *this;
+                --*this;
+                return result;
+            }
+
+            bool operator==(const_iterator const&) const = default;
+
+          private:
+            friend class SmallMap;
+
+            explicit const_iterator(typename flat_type::const_iterator f) :
+                f(f)
+            {
+            }
+
+            explicit const_iterator(typename tree_type::const_iterator t) :
+                t(t),
+                in_tree(true)
+            {
+            }
+
+            typename flat_type::const_iterator f{};
+            typename tree_type::const_iterator t{};
+            bool in_tree{false};
+        };
+
+        using iterator = const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        SmallMap() = default;
+
+        SmallMap(SmallMap const& other) :
+            flat(other.flat),
+            tree(other.tree ? std::make_unique<tree_type>(*other.tree) : nullptr)
+        {
+        }
+
+        SmallMap&
+        operator=(SmallMap const& other)
+        {
+            if (this != &other) {
+                flat = other.flat;
+                tree = other.tree ? std::make_unique<tree_type>(*other.tree) : nullptr;
+            }
+            return *this;
+        }
+
+        SmallMap(SmallMap&&) noexcept = default;
+        SmallMap& operator=(SmallMap&&) noexcept = default;
+        ~SmallMap() = default;
+
+        size_type
+        size() const
+        {
+            return tree ? tree->size() : flat.size();
+        }
+
+        bool
+        empty() const
+        {
+            return size() == 0;
+        }
+
+        iterator
+        begin() const
+        {
+            return tree ? iterator(tree->cbegin()) : iterator(flat.cbegin());
+        }
+
+        iterator
+        end() const
+        {
+            return tree ? iterator(tree->cend()) : iterator(flat.cend());
+        }
+
+        iterator
+        cbegin() const
+        {
+            return begin();
+        }
+
+        iterator
+        cend() const
+        {
+            return end();
+        }
+
+        reverse_iterator
+        rbegin() const
+        {
+            return reverse_iterator(end());
+        }
+
+        reverse_iterator
+        rend() const
+        {
+            return reverse_iterator(begin());
+        }
+
+        reverse_iterator
+        crbegin() const
+        {
+            return rbegin();
+        }
+
+        reverse_iterator
+        crend() const
+        {
+            return rend();
+        }
+
+        template <typename K>
+        iterator
+        lower_bound(K const& key) const
+        {
+            if (tree) {
+                return iterator(tree->lower_bound(key));
+            }
+            return iterator(std::lower_bound(flat.cbegin(), flat.cend(), key, entry_compare()));
+        }
+
+        template <typename K>
+        iterator
+        find(K const& key) const
+        {
+            auto it = lower_bound(key);
+            if (it == end() || Compare()(key, it->first)) {
+                return end();
+            }
+            return it;
+        }
+
+        template <typename K>
+        bool
+        contains(K const& key) const
+        {
+            return find(key) != end();
+        }
+
+        // Insert an entry for key unless there already is one. Return an iterator to the entry for
+        // key and whether an entry was inserted.
+        std::pair<iterator, bool>
+        emplace(Key key, T value)
+        {
+            auto it = lower_bound(key);
+            if (it != end() && !Compare()(key, it->first)) {
+                return {it, false};
+            }
+            return {insert_at(it, std::move(key), std::move(value)), true};
+        }
+
+        // Like emplace, but if the new entry belongs immediately before hint, as is the case when
+        // inserting entries in order with end() as hint, no search is needed.
+        iterator
+        emplace_hint(iterator hint, Key key, T value)
+        {
+            if ((hint == begin() || Compare()(std::prev(hint)->first, key)) &&
+                (hint == end() || Compare()(key, hint->first))) {
+                return insert_at(hint, std::move(key), std::move(value));
+            }
+            return emplace(std::move(key), std::move(value)).first;
+        }
+
+        std::pair<iterator, bool>
+        insert_or_assign(Key key, T value)
+        {
+            auto it = lower_bound(key);
+            if (it != end() && !Compare()(key, it->first)) {
+                it->second = std::move(value);
+                return {it, false};
+            }
+            return {insert_at(it, std::move(key), std::move(value)), true};
+        }
+
+        T&
+        operator[](Key const& key)
+        {
+            auto it = lower_bound(key);
+            if (it == end() || Compare()(key, it->first)) {
+                it = insert_at(it, key, T());
+            }
+            return it->second;
+        }
+
+        iterator
+        erase(iterator pos)
+        {
+            if (tree) {
+                return iterator(tree->erase(pos.t));
+            }
+            return iterator(flat.erase(pos.f));
+        }
+
+      private:
+        // Insert a new entry, which must belong immediately before pos.
+        iterator
+        insert_at(iterator pos, Key key, T value)
+        {
+            if (!tree && flat.size() < max_flat) {
+                return iterator(flat.insert(pos.f, value_type{std::move(key), std::move(value)}));
+            }
+            if (!tree) {
+                tree = std::make_unique<tree_type>(
+                    std::make_move_iterator(flat.begin()), std::make_move_iterator(flat.end()));
+                flat = flat_type();
+                return iterator(tree->emplace(value_type{std::move(key), std::move(value)}).first);
+            }
+            return iterator(tree->emplace_hint(pos.t, value_type{std::move(key), std::move(value)}));
+        }
+
+        flat_type flat;
+        std::unique_ptr<tree_type> tree;
+    };
+} // namespace qpdf
+
+#endif // QPDF_SMALLMAP_HH
@@ -3,6 +3,7 @@
 
 #include <qpdf/assert_debug.h>
 
+#include <array>
 #include <concepts>
 #include <cstdint>
 #include <limits>
@@ -103,6 +104,15 @@ namespace qpdf::util
                             : (digit >= 'A' ? char(digit - 'A' + 10) : '\20'));
     }
 
+    // hex_decode_char as a lookup table indexed by unsigned char, for decoding loops.
+    inline constexpr auto hex_decode_table = [] {
+        std::array<char, 256> table{};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = hex_decode_char(static_cast<char>(i));
+        }
+        return table;
+    }();
+
     inline constexpr bool
     is_hex_digit(char ch)
     {
@@ -0,0 +1,62 @@
+#ifndef QPDF_WORKERPOOL_HH
+#define QPDF_WORKERPOOL_HH
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace qpdf
+{
+    // A fixed number of threads that run submitted tasks in the order in which they were
+    // submitted. The QPDF library is not thread-safe, so tasks must only work on data they own and
+    // must not touch QPDF or QPDFObjectHandle objects. The destructor waits for all submitted
+    // tasks to complete.
+    class WorkerPool
+    {
+      public:
+        explicit WorkerPool(size_t threads);
+        WorkerPool(WorkerPool const&) = delete;
+        WorkerPool& operator=(WorkerPool const&) = delete;
+        ~WorkerPool();
+
+        size_t
+        size() const
+        {
+            return threads.size();
+        }
+
+        // Run f on one of the pool's threads. The returned future yields the result of f or
+        // rethrows any exception thrown by f.
+        template <typename F>
+        std::future<std::invoke_result_t<F>>
+        submit(F&& f)
+        {
+            auto task =
+                std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(f));
+            auto result = task->get_future();
+            {
+                std::lock_guard lock(mutex);
+                tasks.emplace_back([task] { (*task)(); });
+            }
+            cv.notify_one();
+            return result;
+        }
+
+      private:
+        void run();
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::function<void()>> tasks;
+        bool stopping{false};
+        std::vector<std::thread> threads;
+    };
+} // namespace qpdf
+
+#endif // QPDF_WORKERPOOL_HH
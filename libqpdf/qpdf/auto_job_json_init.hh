@@ -335,6 +335,12 @@ popHandler(); // key: coalesceContents
 pushKey("compressionLevel");
 addParameter([this](std::string const& p) { c_main->compressionLevel(p); });
 popHandler(); // key: compressionLevel
+pushKey("compressionThreads");
+addParameter([this](std::string const& p) { c_main->compressionThreads(p); });
+popHandler(); // key: compressionThreads
+pushKey("deflateBlockSize");
+addParameter([this](std::string const& p) { c_main->deflateBlockSize(p); });
+popHandler(); // key: deflateBlockSize
 pushKey("jpegQuality");
 addParameter([this](std::string const& p) { c_main->jpegQuality(p); });
 popHandler(); // key: jpegQuality
@@ -112,6 +112,8 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "suppressRecovery": "suppress error recovery",
   "coalesceContents": "combine content streams",
   "compressionLevel": "set compression level for flate",
+  "compressionThreads": "compress streams on multiple threads",
+  "deflateBlockSize": "compress large streams in parallel blocks",
   "jpegQuality": "set jpeg quality level for jpeg",
   "externalizeInlineImages": "convert inline to regular images",
   "iiMinBytes": "set minimum size for externalizeInlineImages",
@@ -229,6 +229,30 @@ namespace qpdf::global
             }
         }
 
+        static uint32_t const&
+        closed_file_pool_size()
+        {
+            return o.closed_file_pool_size_;
+        }
+
+        static void
+        closed_file_pool_size(uint32_t value)
+        {
+            o.closed_file_pool_size_ = value;
+        }
+
+        static bool const&
+        mmap_input()
+        {
+            return o.mmap_input_;
+        }
+
+        static void
+        mmap_input(bool value)
+        {
+            o.mmap_input_ = value;
+        }
+
         static bool const&
         dct_throw_on_corrupt_data()
         {
@@ -248,6 +272,8 @@ namespace qpdf::global
         bool default_limits_{true};
         bool fuzz_mode_{false};
         bool dct_throw_on_corrupt_data_{true};
+        uint32_t closed_file_pool_size_{64};
+        bool mmap_input_{false};
     };
 } // namespace qpdf::global
 
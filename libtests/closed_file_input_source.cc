@@ -1,5 +1,7 @@
 #include <qpdf/ClosedFileInputSource.hh>
 #include <qpdf/FileInputSource.hh>
+#include <qpdf/MmapInputSource.hh>
+#include <qpdf/global.hh>
 
 #include <cstdio>
 #include <iostream>
@@ -70,9 +72,35 @@ main()
     cf2.stayOpen(true);
     do_tests(&cf2);
     cf2.stayOpen(false);
+    std::cout << "testing with ClosedFileInputSource without file pool\n";
+    qpdf::global::options::closed_file_pool_size(0);
+    ClosedFileInputSource cf3("input");
+    do_tests(&cf3);
+    std::cout << "testing with ClosedFileInputSource sharing a small file pool\n";
+    qpdf::global::options::closed_file_pool_size(1);
+    ClosedFileInputSource cf4("input");
+    ClosedFileInputSource cf5("input");
+    do_tests(&cf4);
+    do_tests(&cf5);
+    // Each access evicts the other source's file from the pool.
+    cf4.seek(11, SEEK_SET);
+    cf5.seek(522, SEEK_SET);
+    check("pooled tell", 11 == cf4.tell());
+    check("pooled read 522", "9 before" == cf5.readLine(100));
+    check("pooled read 11", "Offset 11" == cf4.readLine(100));
+    check("pooled last offset", 522 == cf5.getLastOffset());
+    qpdf::global::options::closed_file_pool_size(64);
     std::cout << "testing with FileInputSource\n";
     FileInputSource f("input");
     do_tests(&f);
+    std::cout << "testing with MmapInputSource\n";
+    check(
+        "mmap off by default",
+        !dynamic_cast<MmapInputSource*>(MmapInputSource::create("input").get()));
+    qpdf::global::options::mmap_input(true);
+    auto mf = MmapInputSource::create("input");
+    qpdf::global::options::mmap_input(false);
+    do_tests(mf.get());
     std::cout << "all assertions passed" << '\n';
     return 0;
 }
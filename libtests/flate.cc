@@ -1,11 +1,20 @@
 
+#include <qpdf/Pipeline_private.hh>
 #include <qpdf/Pl_Count.hh>
+#include <qpdf/Pl_Discard.hh>
 #include <qpdf/Pl_Flate.hh>
+#include <qpdf/Pl_ParallelDeflate.hh>
 #include <qpdf/Pl_StdioFile.hh>
+#include <qpdf/Pl_String.hh>
+#include <qpdf/QPDF.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/WorkerPool.hh>
 
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 void
 run(char const* filename)
@@ -76,14 +85,178 @@ run(char const* filename)
     // At this point, filename, filename.2, and filename.3 should have
     // identical contents.  filename.1 should be a compressed version.
 
+    // Inflate in one step. This fails for incomplete data and if the output would be too large.
+    auto original = QUtil::read_file_into_string(filename);
+    auto compressed = QUtil::read_file_into_string(n1.c_str());
+    std::string inflated;
+    std::cout << "inflate in one step: "
+              << (qpdf::pl::inflate(compressed, inflated, 0, 0) && inflated == original) << '\n';
+    std::cout << "inflate in one step with size hint: "
+              << (qpdf::pl::inflate(compressed, inflated, original.size(), original.size()) &&
+                  inflated == original)
+              << '\n';
+    std::cout << "inflate truncated data: "
+              << qpdf::pl::inflate(
+                     std::string_view(compressed).substr(0, compressed.size() - 5), inflated, 0, 0)
+              << '\n';
+    std::cout << "inflate with too small maximum size: "
+              << qpdf::pl::inflate(compressed, inflated, 0, original.size() - 1) << '\n';
+
+    // Compress in parallel blocks that are smaller and larger than the deflate window and
+    // uncompress the result, which should again be identical to filename.
+    qpdf::WorkerPool workers(3);
+    for (auto [suffix, block_size]: {std::pair{".4", size_t(4096)}, std::pair{".5", size_t(40000)}}) {
+        std::string n = std::string(filename) + suffix;
+        FILE* o = QUtil::safe_fopen(n.c_str(), "wb");
+        Pl_StdioFile out("o", o);
+        Pl_Flate inf("inf", &out, Pl_Flate::a_inflate);
+        Pl_Count count("count", &inf);
+        Pl_ParallelDeflate def("def", &count, workers, block_size);
+        FILE* in = QUtil::safe_fopen(filename, "rb");
+        while ((len = fread(buf, 1, sizeof(buf), in)) > 0) {
+            def.write(buf, len);
+        }
+        fclose(in);
+        def.finish();
+        fclose(o);
+        std::cout << "parallel compressed size is smaller: " << (count.getCount() < 100010)
+                  << '\n';
+    }
+
     std::cout << "done" << '\n';
 }
 
+static std::string
+flate(std::string const& data, Pl_Flate::action_e action)
+{
+    std::string result;
+    Pl_String out("out", nullptr, result);
+    Pl_Flate f("flate", &out, action);
+    f.write(reinterpret_cast<unsigned char const*>(data.data()), data.size());
+    f.finish();
+    return result;
+}
+
+// Collect the raw data of all streams that are only flate-compressed. Files that are not PDF
+// files are compressed and used as a single stream.
+static void
+collect_streams(char const* filename, std::vector<std::string>& streams)
+{
+    std::string data = QUtil::read_file_into_string(filename);
+    if (!data.starts_with("%PDF-")) {
+        streams.emplace_back(flate(data, Pl_Flate::a_deflate));
+        return;
+    }
+    QPDF pdf;
+    pdf.setSuppressWarnings(true);
+    pdf.processFile(filename);
+    for (auto& obj: pdf.getAllObjects()) {
+        if (!obj.isStream()) {
+            continue;
+        }
+        auto filter = obj.getDict().getKey("/Filter");
+        if (filter.isArray() && filter.size() == 1) {
+            filter = filter.getArrayItem(0);
+        }
+        if (filter.isNameAndEquals("/FlateDecode")) {
+            streams.emplace_back(obj.getRawStreamData()->move());
+        }
+    }
+}
+
+// Time inflating and deflating all flate streams from the given files with each available
+// backend, inflating each stream in one step as QPDF does for streams that are in memory. Run
+// this on the performance_check corpus to compare backends, e.g.
+//   flate --benchmark ../performance-test-files/*.pdf
+static void
+benchmark(std::vector<char const*> const& filenames)
+{
+    std::vector<std::string> streams;
+    for (auto filename: filenames) {
+        try {
+            collect_streams(filename, streams);
+        } catch (std::exception& e) {
+            std::cerr << "skipping " << filename << ": " << e.what() << '\n';
+        }
+    }
+    // Use zlib for the reference data. Skip empty streams and streams that zlib can't inflate
+    // completely.
+    Pl_Flate::libdeflate_enabled(Pl_Flate::a_inflate, false);
+    Pl_Flate::libdeflate_enabled(Pl_Flate::a_deflate, false);
+    std::vector<std::pair<std::string, std::string>> data;
+    size_t raw_bytes = 0;
+    size_t bytes = 0;
+    for (auto& raw: streams) {
+        if (raw.empty()) {
+            continue;
+        }
+        try {
+            auto inflated = flate(raw, Pl_Flate::a_inflate);
+            raw_bytes += raw.size();
+            bytes += inflated.size();
+            data.emplace_back(std::move(raw), std::move(inflated));
+        } catch (std::exception&) {
+            // ignore damaged streams
+        }
+    }
+    std::cout << data.size() << " streams, " << raw_bytes << " bytes compressed, " << bytes
+              << " bytes uncompressed" << '\n';
+
+    auto time = [](auto&& f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto report = [&](char const* what, double seconds) {
+        std::cout << what << ": " << seconds << "s, "
+                  << (seconds > 0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0) << " MB/s"
+                  << '\n';
+    };
+    for (bool libdeflate: {false, true}) {
+        if (libdeflate && !Pl_Flate::libdeflate_supported()) {
+            std::cout << "libdeflate: not supported" << '\n';
+            continue;
+        }
+        Pl_Flate::libdeflate_enabled(Pl_Flate::a_inflate, libdeflate);
+        Pl_Flate::libdeflate_enabled(Pl_Flate::a_deflate, libdeflate);
+        char const* name = libdeflate ? "libdeflate" : "zlib";
+        report((std::string(name) + " inflate").c_str(), time([&]() {
+                   std::string out;
+                   for (auto const& [raw, inflated]: data) {
+                       if (!qpdf::pl::inflate(raw, out, 0, 0) || out != inflated) {
+                           throw std::runtime_error(std::string(name) + ": inflate mismatch");
+                       }
+                   }
+               }));
+        report((std::string(name) + " deflate").c_str(), time([&]() {
+                   for (auto const& [raw, inflated]: data) {
+                       Pl_Discard discard;
+                       Pl_Flate def("def", &discard, Pl_Flate::a_deflate);
+                       def.write(
+                           reinterpret_cast<unsigned char const*>(inflated.data()),
+                           inflated.size());
+                       def.finish();
+                   }
+               }));
+    }
+    std::cout << "benchmark done" << '\n';
+}
+
 int
 main(int argc, char* argv[])
 {
+    if (argc > 2 && strcmp(argv[1], "--benchmark") == 0) {
+        try {
+            benchmark(std::vector<char const*>(argv + 2, argv + argc));
+        } catch (std::exception& e) {
+            std::cerr << e.what() << '\n';
+            exit(2);
+        }
+        return 0;
+    }
     if (argc != 2) {
         std::cerr << "Usage: pipeline filename" << '\n';
+        std::cerr << "       pipeline --benchmark file ..." << '\n';
         exit(2);
     }
     char* filename = argv[1];
@@ -187,6 +187,12 @@ test_1(QPDF&, char const*)
     // Check default for TIFF memory limit
     assert(tiff_max_memory() == 0);
 
+    // Check default for ClosedFileInputSource pool size
+    assert(closed_file_pool_size() == 64);
+
+    // Check default for memory-mapping input files
+    assert(!mmap_input());
+
     // Set DCT limits and throw flag via global limits and verify
     dct_max_memory(123456);
     dct_max_progressive_scans(7);
@@ -201,6 +207,10 @@ test_1(QPDF&, char const*)
     run_length_max_memory(111000);
     // Set TIFF limit and verify
     tiff_max_memory(7654321);
+    // Set ClosedFileInputSource pool size and verify
+    closed_file_pool_size(3);
+    // Enable memory-mapping input files and verify
+    mmap_input(true);
 
     assert(dct_max_memory() == 123456);
     assert(get_uint32(qpdf_p_dct_max_memory) == 123456);
@@ -216,6 +226,10 @@ test_1(QPDF&, char const*)
     assert(get_uint32(qpdf_p_run_length_max_memory) == 111000);
     assert(tiff_max_memory() == 7654321);
     assert(get_uint32(qpdf_p_tiff_max_memory) == 7654321);
+    assert(closed_file_pool_size() == 3);
+    assert(get_uint32(qpdf_p_closed_file_pool_size) == 3);
+    assert(mmap_input());
+    assert(get_uint32(qpdf_p_mmap_input) == 1);
     assert(doc_max_warnings() == 77);
 
     // Now set via Pl_DCT, Pl_PNGFilter, Pl_Flate, and Pl_RunLength helpers and verify they update
@@ -274,6 +288,10 @@ test_2(QPDF&, char const*)
     assert(tiff_max_memory() == 44444);
     set_uint32(qpdf_p_doc_max_warnings, 444);
     assert(doc_max_warnings() == 444);
+    set_uint32(qpdf_p_closed_file_pool_size, 0);
+    assert(closed_file_pool_size() == 0);
+    set_uint32(qpdf_p_mmap_input, 1);
+    assert(mmap_input());
 }
 
 // Test fuzz_mode behavior
@@ -1,6 +1,8 @@
 #include <qpdf/Buffer.hh>
 #include <qpdf/BufferInputSource.hh>
+#include <qpdf/InputSource_private.hh>
 #include <qpdf/QPDFTokenizer.hh>
+#include <qpdf/ReadAheadInputSource.hh>
 #include <cstring>
 #include <iostream>
 
@@ -86,5 +88,58 @@ main()
     check("findLast found potato salad", true, is->findLast("potato", 0, 0, f1));
     check("findLast found first one", true, is->tell() == 2056);
 
+    // Views are equivalent to reads except that they don't copy. They are only available for input
+    // sources that implement is::Memory.
+    check("buffer input source not in memory", false, qpdf::is::in_memory(*is));
+    check("no view of buffer input source", false, qpdf::is::view(*is, 6, 2037).has_value());
+    auto ob = std::make_shared<qpdf::is::OffsetBuffer>("test offset buffer", b1.get());
+    check("offset buffer in memory", true, qpdf::is::in_memory(*ob));
+    auto v = qpdf::is::view(*ob, 6, 2037);
+    check("view data", true, v && *v == "potato");
+    check("view last offset", true, ob->getLastOffset() == 2037);
+    check("view tell", true, ob->tell() == 2043);
+    v = qpdf::is::view(*ob, 100, 3160);
+    check("view truncated at EOF", true, v && *v == "potatopotato");
+    check("view at EOF", true, qpdf::is::view(*ob, 1) == std::string_view());
+    check("view at EOF last offset", true, ob->getLastOffset() == 3172);
+
+    // A read-ahead input source behaves like the source it wraps.
+    check("read ahead in-memory source", true, ReadAheadInputSource::create(ob) == ob);
+    check("read ahead other source", false, ReadAheadInputSource::create(is) == is);
+    std::string lines;
+    for (int i = 0; i < 5000; ++i) {
+        lines += "line " + std::to_string(i) + (i % 3 ? "\n" : "\r\n");
+    }
+    lines += "no eol";
+    auto plain = std::make_shared<qpdf::is::OffsetBuffer>("lines", lines);
+    auto ra = std::make_shared<ReadAheadInputSource>(
+        std::make_shared<qpdf::is::OffsetBuffer>("lines", lines), 0);
+    bool same = true;
+    while (plain->tell() < static_cast<qpdf_offset_t>(lines.size())) {
+        same = same && plain->readLine(4) == ra->readLine(4) &&
+            plain->getLastOffset() == ra->getLastOffset() &&
+            plain->findAndSkipNextEOL() == ra->findAndSkipNextEOL() && plain->tell() == ra->tell();
+    }
+    check("read ahead sequential scan", true, same && ra->findAndSkipNextEOL() == plain->tell());
+    char b2[20000];
+    ra->seek(100, SEEK_SET);
+    check(
+        "read ahead seek back",
+        true,
+        ra->read(b2, 10) == 10 && std::string_view(b2, 10) == lines.substr(100, 10));
+    ra->seek(-20000, SEEK_END);
+    check(
+        "read ahead large read",
+        true,
+        ra->read(b2, sizeof(b2)) == sizeof(b2) &&
+            std::string_view(b2, sizeof(b2)) == std::string_view(lines).substr(lines.size() - 20000));
+    check("read ahead at EOF", true, ra->read(b2, 1) == 0);
+    ra->seek(8190, SEEK_SET);
+    ra->unreadCh('x');
+    check(
+        "read ahead across blocks",
+        true,
+        ra->read(b2, 10) == 10 && std::string_view(b2, 10) == lines.substr(8189, 10));
+
     return 0;
 }
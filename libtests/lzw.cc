@@ -1,10 +1,48 @@
 #include <qpdf/Pl_LZWDecoder.hh>
 
 #include <qpdf/Pl_StdioFile.hh>
+#include <qpdf/Pl_String.hh>
 #include <qpdf/QUtil.hh>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Decode an LZW-encoded file repeatedly and report the throughput in terms of decoded bytes,
+// e.g.
+//
+//   lzw --benchmark qtest/lzw/lzw1.in
+static void
+benchmark(char const* filename, bool early_code_change)
+{
+    static constexpr int iterations = 100;
+    auto data = QUtil::read_file_into_string(filename);
+    auto decode = [&]() {
+        std::string out;
+        Pl_String s("output", nullptr, out);
+        Pl_LZWDecoder d("decode", &s, early_code_change);
+        d.write(reinterpret_cast<unsigned char const*>(data.data()), data.size());
+        d.finish();
+        return out;
+    };
+    auto expected = decode();
+    std::cout << data.size() << " bytes encoded, " << expected.size() << " bytes decoded" << '\n';
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        if (decode() != expected) {
+            throw std::runtime_error("decode mismatch");
+        }
+    }
+    auto seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto bytes = static_cast<double>(expected.size()) * iterations;
+    std::cout << "decode: " << seconds << "s, " << (seconds > 0 ? bytes / 1e6 / seconds : 0.0)
+              << " MB/s" << '\n';
+    std::cout << "benchmark done" << '\n';
+}
 
 int
 main(int argc, char* argv[])
@@ -16,9 +54,20 @@ main(int argc, char* argv[])
 
     if (argc < 3) {
         std::cerr << "Usage: lzw infile outfile [ --no-early-code-change ]" << '\n';
+        std::cerr << "       lzw --benchmark infile [ --no-early-code-change ]" << '\n';
         exit(2);
     }
 
+    if (strcmp(argv[1], "--benchmark") == 0) {
+        try {
+            benchmark(argv[2], early_code_change);
+        } catch (std::exception& e) {
+            std::cerr << e.what() << '\n';
+            exit(2);
+        }
+        return 0;
+    }
+
     try {
         char* infilename = argv[1];
         char* outfilename = argv[2];
@@ -0,0 +1,88 @@
+#include <qpdf/assert_test.h>
+
+#include <qpdf/ObjGenMap.hh>
+
+#include <iostream>
+#include <map>
+
+using namespace qpdf;
+
+using Map = ObjGenMap<int>;
+
+static void
+check(Map const& m, std::map<QPDFObjGen, int> const& expected)
+{
+    assert(m.size() == expected.size());
+    assert(m.map() == expected);
+    for (auto const& [og, value]: expected) {
+        assert(m.contains(og));
+        assert(m.find(og)->second == value);
+        // Other generations and neighbouring ids are only found if they are present.
+        for (auto other: {QPDFObjGen(og.getObj(), og.getGen() + 1),
+                          QPDFObjGen(og.getObj() + 1, og.getGen())}) {
+            assert(m.contains(other) == expected.contains(other));
+        }
+    }
+    assert(!m.contains(QPDFObjGen(0, 0)) || expected.contains(QPDFObjGen(0, 0)));
+}
+
+int
+main()
+{
+    Map m;
+    std::map<QPDFObjGen, int> expected;
+    check(m, expected);
+
+    // Dense ids, inserted out of order, with a few extra generations.
+    for (int i = 3000; i > 0; i -= 3) {
+        for (int j = 0; j < 3; ++j) {
+            m[QPDFObjGen(i - j, 0)] = i - j;
+            expected[QPDFObjGen(i - j, 0)] = i - j;
+        }
+    }
+    for (int i: {5, 17, 2999}) {
+        assert(m.try_emplace(QPDFObjGen(i, 2), -i).second);
+        expected[QPDFObjGen(i, 2)] = -i;
+    }
+    assert(!m.try_emplace(QPDFObjGen(5, 2), 42).second);
+    assert(!m.insert({QPDFObjGen(6, 0), 42}).second);
+    check(m, expected);
+
+    // Very large ids are not indexed but are still found.
+    m[QPDFObjGen(2000000000, 0)] = 1;
+    expected[QPDFObjGen(2000000000, 0)] = 1;
+    check(m, expected);
+
+    // Erasing the indexed generation of an object leaves the other one reachable.
+    for (auto og: {QPDFObjGen(5, 0), QPDFObjGen(17, 2), QPDFObjGen(100, 0)}) {
+        assert(m.erase(og) == 1);
+        expected.erase(og);
+    }
+    assert(m.erase(QPDFObjGen(100, 0)) == 0);
+    m.erase(m.find(QPDFObjGen(2999, 0)));
+    expected.erase(QPDFObjGen(2999, 0));
+    check(m, expected);
+
+    // Copies and moves keep working independently.
+    Map copy = m;
+    copy[QPDFObjGen(100, 0)] = 100;
+    check(m, expected);
+    Map moved = std::move(copy);
+    auto with_100 = expected;
+    with_100[QPDFObjGen(100, 0)] = 100;
+    check(moved, with_100);
+    m = std::move(moved);
+    check(m, with_100);
+    m[QPDFObjGen(4000, 0)] = 4000;
+    with_100[QPDFObjGen(4000, 0)] = 4000;
+    check(m, with_100);
+    assert(m.rbegin()->first == QPDFObjGen(2000000000, 0));
+
+    m.clear();
+    check(m, {});
+    m[QPDFObjGen(1, 0)] = 1;
+    check(m, {{QPDFObjGen(1, 0), 1}});
+
+    std::cout << "obj gen map tests done" << '\n';
+    return 0;
+}
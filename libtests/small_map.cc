@@ -0,0 +1,151 @@
+#include <qpdf/assert_test.h>
+
+#include <qpdf/Atom.hh>
+#include <qpdf/QPDFObjectHandle.hh>
+#include <qpdf/SmallMap.hh>
+
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace qpdf;
+
+using Map = SmallMap<Key, int, std::less<>, 4>;
+
+static void
+check(Map const& m, std::map<std::string, int> const& expected)
+{
+    assert(m.size() == expected.size());
+    auto it = expected.begin();
+    for (auto const& [key, value]: m) {
+        assert(it != expected.end());
+        assert(key == it->first);
+        assert(value == it->second);
+        assert(m.contains(it->first));
+        assert(m.find(it->first)->second == value);
+        ++it;
+    }
+    auto rit = expected.rbegin();
+    for (auto i = m.rbegin(); i != m.rend(); ++i, ++rit) {
+        assert(i->first == rit->first);
+    }
+}
+
+static void
+test_map()
+{
+    Map m;
+    std::map<std::string, int> expected;
+    assert(m.empty());
+    assert(m.begin() == m.end());
+    assert(!m.contains("/Type"));
+
+    // Insert out of order so that entries have to be moved while the map is flat and after it has
+    // switched to a tree.
+    int n = 0;
+    for (auto name: {"/Type", "/Potato", "/A", "/Length", "/Zebra", "/Filter", "/B", "/Quack"}) {
+        auto [it, inserted] = m.emplace(Key(name), ++n);
+        assert(inserted);
+        assert(it->first == name && it->second == n);
+        expected[name] = n;
+        check(m, expected);
+    }
+    assert(!m.emplace(Key("/Type"), 42).second);
+    assert(m.find("/Type")->second == 1);
+    assert(!m.insert_or_assign(Key("/Type"), 42).second);
+    expected["/Type"] = 42;
+    m[Key("/Missing")] = 7;
+    expected["/Missing"] = 7;
+    m.find("/Length")->second = 9;
+    expected["/Length"] = 9;
+    check(m, expected);
+
+    m.erase(m.find("/A"));
+    expected.erase("/A");
+    m.erase(m.find("/Zebra"));
+    expected.erase("/Zebra");
+    check(m, expected);
+    assert(m.find("/A") == m.end());
+
+    // Copies are independent.
+    Map copy = m;
+    copy[Key("/Copy")] = 1;
+    assert(!m.contains("/Copy"));
+    check(m, expected);
+
+    // Flat maps filled in order with end() as hint.
+    Map flat;
+    for (auto name: {"/A", "/B", "/C"}) {
+        flat.emplace_hint(flat.end(), Key(name), 1);
+    }
+    flat.emplace_hint(flat.begin(), Key("/D"), 2);
+    check(flat, {{"/A", 1}, {"/B", 1}, {"/C", 1}, {"/D", 2}});
+    Map flat_copy;
+    flat_copy = flat;
+    flat.erase(flat.begin());
+    check(flat_copy, {{"/A", 1}, {"/B", 1}, {"/C", 1}, {"/D", 2}});
+}
+
+static void
+test_keys()
+{
+    assert(atom::find("/Type") == atom::Type);
+    assert(atom::find("Type") == atom::none);
+    assert(atom::find("/Potato") == atom::none);
+    assert(atom::name(atom::Length) == "/Length");
+    assert(atom::name(atom::none).empty());
+    for (int i = 1; i < atom::count; ++i) {
+        auto a = static_cast<atom::id>(i);
+        assert(atom::find(atom::name(a)) == a);
+        assert(atom::find(atom::name(a) + "X") == atom::none);
+    }
+    assert(Key(atom::Filter) == Key("/Filter"));
+    assert(Key("/Filter").atom() == atom::Filter);
+    assert(Key("/Potato").atom() == atom::none);
+    assert(Key(std::string("/Type")).name() == "/Type");
+    assert(Key(std::string_view("/Type")).atom() == atom::Type);
+    assert(Key("/Type") == "/Type");
+    assert(Key("/Potato") < std::string("/Type") && std::string("/Type") < Key("/Width"));
+    // Keys with and without atoms are ordered like their names.
+    assert(Key("/Filter") < Key("/Length"));
+    assert(Key("/Fi") < Key("/Filter"));
+    assert(Key("/Filter") < Key("/Filter2"));
+    assert(!(Key("/Type") < Key("/Type")));
+}
+
+static void
+test_dictionary()
+{
+    // Dictionaries that switch from a flat representation to a tree keep their order and null
+    // semantics.
+    auto dict = QPDFObjectHandle::newDictionary();
+    std::string expected = "<< ";
+    for (char c = 'Z'; c >= 'A'; --c) {
+        dict.replaceKey(std::string("/") + c, QPDFObjectHandle::newInteger(c));
+    }
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        expected += std::string("/") + c + " " + std::to_string(int(c)) + " ";
+    }
+    expected += ">>";
+    assert(dict.unparse() == expected);
+    dict.replaceKey("/M", QPDFObjectHandle::newNull());
+    assert(!dict.hasKey("/M"));
+    assert(dict.getKeys().size() == 25);
+    dict.removeKey("/A");
+    assert(dict.getDictAsMap().size() == 24);
+
+    auto small = QPDFObjectHandle::parse("<< /Type /Page /Z 1 /A null /Length 3 >>");
+    assert(small.unparse() == "<< /Length 3 /Type /Page /Z 1 >>");
+    assert(!small.hasKey("/A"));
+    assert(small.getKey("/Length").getIntValue() == 3);
+}
+
+int
+main()
+{
+    test_map();
+    test_keys();
+    test_dictionary();
+    std::cout << "small map tests done" << '\n';
+    return 0;
+}
@@ -6,6 +6,8 @@
 #include <qpdf/QPDF.hh>
 
 #include <qpdf/BufferInputSource.hh>
+#include <qpdf/ClosedFileInputSource.hh>
+#include <qpdf/FileInputSource.hh>
 #include <qpdf/Pl_Buffer.hh>
 #include <qpdf/Pl_Discard.hh>
 #include <qpdf/Pl_Flate.hh>
@@ -27,7 +29,9 @@
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
 #include <qpdf/global.hh>
+#include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -183,6 +187,43 @@ print_rect(std::ostream& out, QPDFObjectHandle::Rectangle const& r)
     out << "[" << r.llx << ", " << r.lly << ", " << r.urx << ", " << r.ury << "]";
 }
 
+static std::string
+write_to_string(QPDF& pdf)
+{
+    QPDFWriter w(pdf);
+    w.setOutputMemory();
+    w.setStaticID(true);
+    w.write();
+    auto b = w.getBufferSharedPointer();
+    return {reinterpret_cast<char const*>(b->getBuffer()), b->getSize()};
+}
+
+static std::vector<std::string>
+unparse_all_objects(QPDF& pdf)
+{
+    std::vector<std::string> result;
+    for (auto& obj: pdf.getAllObjects()) {
+        result.emplace_back(obj.unparseResolved());
+    }
+    return result;
+}
+
+// Call f for each direct array that is the value of a dictionary key.
+template <typename F>
+static void
+for_each_direct_array(QPDF& pdf, F f)
+{
+    for (auto& obj: pdf.getAllObjects()) {
+        if (obj.isDictionary()) {
+            for (auto& [key, value]: obj.getDictAsMap()) {
+                if (!value.isIndirect() && value.isArray()) {
+                    f(value);
+                }
+            }
+        }
+    }
+}
+
 #define assert_compare_numbers(expected, expr) compare_numbers(#expr, expected, expr)
 
 template <typename T1, typename T2>
@@ -3598,6 +3639,204 @@ test_102(QPDF& pdf, char const* arg2)
     j2.writeQPDF(*q);
 }
 
+static void
+test_103(QPDF& pdf, char const* arg2)
+{
+    // Write with indirect stream lengths from an input that is not held in memory, so that
+    // unfiltered stream data is written straight to the output. Read the output back and check
+    // that stream data and lengths are intact, with and without encryption.
+    auto stream_data = [](QPDF& q) {
+        std::vector<std::string> result;
+        for (auto& obj: q.getAllObjects()) {
+            if (obj.isStream()) {
+                auto buf = obj.getRawStreamData();
+                result.emplace_back(
+                    reinterpret_cast<char const*>(buf->getBuffer()), buf->getSize());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    QPDF in;
+    in.processInputSource(std::make_shared<ClosedFileInputSource>(arg2));
+    auto expected = stream_data(in);
+    for (int i: {0, 1, 2}) {
+        QPDFWriter w(in);
+        w.setOutputMemory();
+        w.setStaticID(true);
+        w.setStreamDataMode(qpdf_s_preserve);
+        w.setDirectStreamLengths(false);
+        if (i == 1) {
+            w.setR3EncryptionParametersInsecure(
+                "u", "o", true, true, true, true, true, true, qpdf_r3p_full);
+        } else if (i == 2) {
+            w.setR6EncryptionParameters(
+                "u", "o", true, true, true, true, true, true, qpdf_r3p_full, true);
+        }
+        w.write();
+        auto b = w.getBufferSharedPointer();
+        QPDF out;
+        out.processMemoryFile(
+            "indirect lengths",
+            reinterpret_cast<char const*>(b->getBuffer()),
+            b->getSize(),
+            i ? "u" : nullptr);
+        for (auto& obj: out.getAllObjects()) {
+            if (obj.isStream()) {
+                assert(obj.getDict().getKey("/Length").isIndirect());
+            }
+        }
+        assert(stream_data(out) == expected);
+    }
+
+    // QDF mode requires indirect stream lengths, so asking for direct ones is ignored.
+    QPDFWriter w(in);
+    w.setOutputMemory();
+    w.setStaticID(true);
+    w.setQDFMode(true);
+    w.setDirectStreamLengths(true);
+    w.write();
+    auto b = w.getBufferSharedPointer();
+    QPDF out;
+    out.processMemoryFile("qdf", reinterpret_cast<char const*>(b->getBuffer()), b->getSize());
+    for (auto& obj: out.getAllObjects()) {
+        if (obj.isStream()) {
+            assert(obj.getDict().getKey("/Length").isIndirect());
+        }
+    }
+}
+
+static void
+test_105(QPDF& pdf, char const* arg2)
+{
+    // Read a file with and without lazy arrays. Elements accessed in any order, objects, and
+    // output must be the same, and arrays must remain usable after the QPDF that read them has been
+    // destroyed.
+    QPDF plain;
+    plain.processFile(arg2);
+    auto expected = unparse_all_objects(plain);
+    std::vector<std::string> expected_items;
+    for_each_direct_array(plain, [&expected_items](QPDFObjectHandle& value) {
+        for (int i = value.getArrayNItems() - 1; i >= 0; --i) {
+            expected_items.emplace_back(value.getArrayItem(i).unparse());
+        }
+    });
+
+    std::vector<QPDFObjectHandle> kept;
+    {
+        auto q = QPDF::create();
+        q->setLazyArrays(true);
+        q->processFile(arg2);
+        std::vector<std::string> items;
+        for_each_direct_array(*q, [&items](QPDFObjectHandle& value) {
+            for (int i = value.getArrayNItems() - 1; i >= 0; --i) {
+                items.emplace_back(value.getArrayItem(i).unparse());
+            }
+        });
+        assert(items == expected_items);
+        assert(unparse_all_objects(*q) == expected);
+        assert(write_to_string(*q) == write_to_string(plain));
+
+        // Keep arrays none of whose elements have been accessed.
+        auto fresh = QPDF::create();
+        fresh->setLazyArrays(true);
+        fresh->processFile(arg2);
+        for_each_direct_array(*fresh, [&kept](QPDFObjectHandle& value) { kept.emplace_back(value); });
+    }
+    size_t i = 0;
+    for_each_direct_array(plain, [&kept, &i](QPDFObjectHandle& value) {
+        auto& array = kept.at(i++);
+        assert(array.getArrayNItems() == value.getArrayNItems());
+        for (int j = 0; j < value.getArrayNItems(); ++j) {
+            auto item = array.getArrayItem(j);
+            if (value.getArrayItem(j).isIndirect()) {
+                assert(item.isDestroyed());
+            } else {
+                assert(item.unparse() == value.getArrayItem(j).unparse());
+            }
+        }
+    });
+    assert(i == kept.size() && i > 0);
+
+    // Show that arrays were actually read lazily: read the file from memory, blank out the data
+    // once all objects have been read, and access the elements only then. Integers and references
+    // are recorded while scanning, but other elements of lazily read arrays are parsed from the
+    // blanked data and therefore come out as null. Report how many elements that affected.
+    auto data = QUtil::read_file_into_string(arg2);
+    std::vector<QPDFObjectHandle> unread;
+    auto lazy = QPDF::create();
+    lazy->setSuppressWarnings(true);
+    lazy->setLazyArrays(true);
+    lazy->processMemoryFile(arg2, data.data(), data.size());
+    for_each_direct_array(*lazy, [&unread](QPDFObjectHandle& value) { unread.emplace_back(value); });
+    std::fill(data.begin(), data.end(), ' ');
+    size_t deferred = 0;
+    i = 0;
+    for_each_direct_array(plain, [&unread, &i, &deferred](QPDFObjectHandle& value) {
+        auto& array = unread.at(i++);
+        assert(array.getArrayNItems() == value.getArrayNItems());
+        for (int j = 0; j < value.getArrayNItems(); ++j) {
+            auto item = array.getArrayItem(j);
+            if (item.unparse() != value.getArrayItem(j).unparse()) {
+                assert(item.isNull());
+                ++deferred;
+            }
+        }
+    });
+    std::cout << "elements parsed on access: " << deferred << '\n';
+}
+
+static void
+test_106(QPDF& pdf, char const* arg2)
+{
+    // An exception from the pipeline that receives decoded stream data is reported as a warning
+    // and makes pipeStreamData return false regardless of whether the input is memory-mapped,
+    // which allows streams to be decoded in one step.
+    class Fail: public Pipeline
+    {
+      public:
+        Fail() :
+            Pipeline("fail", nullptr)
+        {
+        }
+        void
+        write(unsigned char const*, size_t) final
+        {
+            throw std::runtime_error("downstream failure");
+        }
+        void
+        finish() final
+        {
+        }
+    };
+    auto check = [](QPDF& q) {
+        q.setSuppressWarnings(true);
+        std::vector<std::string> messages;
+        for (auto& obj: q.getAllObjects()) {
+            if (obj.isStream() && obj.getDict().hasKey("/Filter")) {
+                Fail fail;
+                bool filtered = false;
+                assert(!obj.pipeStreamData(&fail, &filtered, 0, qpdf_dl_generalized, false, true));
+            }
+        }
+        for (auto const& w: q.getWarnings()) {
+            messages.emplace_back(w.getMessageDetail());
+        }
+        return messages;
+    };
+
+    QPDF mapped;
+    mapped.processFile(arg2);
+    QPDF file;
+    file.processInputSource(std::make_shared<FileInputSource>(arg2));
+    auto messages = check(mapped);
+    assert(!messages.empty() && messages == check(file));
+    for (auto const& message: messages) {
+        std::cout << message << '\n';
+    }
+}
+
 void
 runtest(int n, char const* filename1, char const* arg2)
 {
@@ -3605,7 +3844,8 @@ runtest(int n, char const* filename1, char const* arg2)
     // the test suite to see how the test is invoked to find the file
     // that the test is supposed to operate on.
 
-    std::set<int> ignore_filename = {61, 62, 81, 83, 84, 85, 86, 87, 92, 95, 96, 101, 102};
+    std::set<int> ignore_filename = {
+        61, 62, 81, 83, 84, 85, 86, 87, 92, 95, 96, 101, 102, 103, 105, 106};
 
     if (n == 0) {
         // Throw in some random test cases that don't fit anywhere
@@ -3624,6 +3864,38 @@ runtest(int n, char const* filename1, char const* arg2)
         QPDFObjectHandle uninitialized;
         assert(uninitialized.getTypeCode() == ::ot_uninitialized);
         assert(strcmp(uninitialized.getTypeName(), "uninitialized") == 0);
+
+        // Reals keep their exact text, however they are stored internally.
+        for (auto r:
+             {"1.5", "-.5", "+0.50", "007.250", "5.", "-0.0", ".0", "123456789012345.",
+              "1234567890123456.5", "-.000000000000001", "1e5", "1.2.3", "-", "."}) {
+            auto real = QPDFObjectHandle::newReal(r);
+            assert(real.getRealValue() == r);
+            assert(real.unparse() == r);
+            assert(real.getNumericValue() == atof(r));
+            assert(std::signbit(real.getNumericValue()) == std::signbit(atof(r)));
+            assert(real.shallowCopy().getRealValue() == r);
+        }
+
+        // Integers are converted while they are tokenized.
+        auto ints = QPDFObjectHandle::parse(
+            "[ 0 -0 +17 007 -42 9223372036854775807 -9223372036854775808 1.5 ]");
+        assert(ints.getArrayItem(0).getIntValue() == 0);
+        assert(ints.getArrayItem(1).getIntValue() == 0);
+        assert(ints.getArrayItem(2).getIntValue() == 17);
+        assert(ints.getArrayItem(3).getIntValue() == 7);
+        assert(ints.getArrayItem(4).getIntValue() == -42);
+        assert(ints.getArrayItem(5).getIntValue() == LLONG_MAX);
+        assert(ints.getArrayItem(6).getIntValue() == LLONG_MIN);
+        assert(ints.getArrayItem(7).isReal());
+        assert(QPDFObjectHandle::parse("123456789").getIntValue() == 123456789);
+        try {
+            QPDFObjectHandle::parse("9223372036854775808");
+            assert(false);
+        } catch (std::exception& e) {
+            assert(
+                std::string(e.what()).find("overflow/underflow converting") != std::string::npos);
+        }
     }
 
     QPDF pdf;
@@ -3699,7 +3971,9 @@ runtest(int n, char const* filename1, char const* arg2)
         {85, test_85},   {86, test_86},   {87, test_87},  {88, test_88}, {89, test_89},
         {90, test_90},   {91, test_91},   {92, test_92},  {93, test_93}, {94, test_94},
         {95, test_95},   {96, test_96},   {97, test_97},  {98, test_98}, {99, test_99},
-        {100, test_100}, {101, test_101}, {102, test_102}};
+        {100, test_100}, {101, test_101}, {102, test_102}, {103, test_103},
+        {105, test_105},
+        {106, test_106}};
 
     auto fn = test_functions.find(n);
     if (fn == test_functions.end()) {